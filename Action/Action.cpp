@@ -1,20 +1,144 @@
 #include "pch.h"
 #include "Action.h"
+#include "ActionList.h"
+#include "ActionNameIndex.h"
+#include "Entity.h"
 
 namespace FieaGameEngine
 {
     RTTI_DEFINITIONS(Action);
 
+    const std::uint8_t Action::m_nameWriteHook = Datum::RegisterWriteHook(&Action::OnNameWritten);
+
     Action::Action(RTTI::IdType type)
         : Attributed(type)
     {
+        m_order[m_nameIndex].second.SetWriteHook(m_nameWriteHook);
+    }
+
+    Action::Action(const Action& other)
+        : Attributed(other), m_name(other.m_name)
+    {
+    }
+
+    Action::Action(Action&& other)
+        : Attributed(std::move(other)), m_name(std::move(other.m_name)), m_indexedPosition(other.m_indexedPosition)
+    {
+        // Scope's move constructor already put us in the other's place, but couldn't reach us yet
+        UpdateIndex();
     }
 
-    const Vector<Signature> Action::Signatures()
+    Action& Action::operator=(const Action& other)
     {
-        return Vector<Signature>
+        if (this != &other)
+        {
+            Attributed::operator=(other);
+            m_name = other.m_name;
+            UpdateIndex();
+        }
+
+        return *this;
+    }
+
+    Action& Action::operator=(Action&& other)
+    {
+        if (this != &other)
+        {
+            Attributed::operator=(std::move(other));
+            m_name = std::move(other.m_name);
+            UpdateIndex();
+        }
+
+        return *this;
+    }
+
+    Action::~Action()
+    {
+        // A compiled program may still point at us
+        if (m_parent != nullptr)
+        {
+            Entity::InvalidateActionProgram(*m_parent);
+        }
+
+        if (m_indexedIn != nullptr)
+        {
+            m_indexedIn->Remove(*this);
+        }
+    }
+
+    void Action::Init(WorldState*)
+    {
+    }
+
+    void Action::SetName(const std::string& name)
+    {
+        m_order[m_nameIndex].second.Set(name);
+    }
+
+    bool Action::FindByName(Scope& owner, const std::string& name, Datum*& actions, size_t& index)
+    {
+        ActionNameIndex* nameIndex = IndexOf(owner);
+        return nameIndex != nullptr && nameIndex->Find(owner, name, actions, index);
+    }
+
+    void Action::OnParentChanged(Scope* previousParent)
+    {
+        UpdateIndex();
+
+        // The action trees of both the old and new owning Entity changed shape
+        if (previousParent != nullptr)
+        {
+            Entity::InvalidateActionProgram(*previousParent);
+        }
+
+        if (m_parent != nullptr)
+        {
+            Entity::InvalidateActionProgram(*m_parent);
+        }
+    }
+
+    ActionNameIndex* Action::IndexOf(Scope& owner)
+    {
+        Entity* entity = owner.As<Entity>();
+        if (entity != nullptr)
+        {
+            return &entity->ActionIndex();
+        }
+
+        ActionList* actionList = owner.As<ActionList>();
+        return (actionList != nullptr) ? &actionList->ActionIndex() : nullptr;
+    }
+
+    void Action::OnNameWritten(void* storage, size_t)
+    {
+        Action& action = *reinterpret_cast<Action*>(static_cast<char*>(storage) - offsetof(Action, m_name));
+        if (action.m_indexedIn != nullptr)
+        {
+            action.m_indexedIn->Rename(action);
+        }
+    }
+
+    void Action::UpdateIndex()
+    {
+        ActionNameIndex* nameIndex = (m_parent != nullptr) ? IndexOf(*m_parent) : nullptr;
+        if (nameIndex == m_indexedIn)
+        {
+            if (m_indexedIn != nullptr)
+            {
+                m_indexedIn->Rename(*this);
+            }
+
+            return;
+        }
+
+        if (m_indexedIn != nullptr)
+        {
+            m_indexedIn->Remove(*this);
+        }
+
+        if (nameIndex != nullptr)
         {
-            { "Name", Datum::DatumType::String, 1, offsetof(Action, m_name) }
-        };
+            nameIndex->Add(*this);
+        }
     }
-}
\ No newline at end of file
+}
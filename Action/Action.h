@@ -5,6 +5,7 @@
 namespace FieaGameEngine
 {
     class WorldState;
+    class ActionNameIndex;
 
     class Action : public Attributed
     {
@@ -18,33 +19,33 @@ namespace FieaGameEngine
         Action(RTTI::IdType type);
 
         /// <summary>
-        /// Default copy constructor 
+        /// Copy constructor. The copy has no parent, so it isn't in a name index yet.
         /// </summary>
         /// <param name="other"> The Action to copy </param>
-        Action(const Action& other) = default;
+        Action(const Action& other);
 
         /// <summary>
-        /// Default move constructor 
+        /// Move constructor. The new Action takes the other's place in its parent's name index.
         /// </summary>
         /// <param name="other"> The Action to move </param>
-        Action(Action&& other) = default;
+        Action(Action&& other);
 
         /// <summary>
-        /// Default copy assignment 
+        /// Copy assignment 
         /// </summary>
         /// <param name="other"> The Action to copy </param>
-        Action& operator=(const Action& other) = default;
+        Action& operator=(const Action& other);
 
         /// <summary>
-        /// Default move assignment 
+        /// Move assignment 
         /// </summary>
         /// <param name="other"> The Action to move </param>
-        Action& operator=(Action&& other) = default;
+        Action& operator=(Action&& other);
 
         /// <summary>
-        /// Default destructor
+        /// Destructor that removes this Action from its parent's name index
         /// </summary>
-        virtual ~Action() = default;
+        virtual ~Action();
 
         /// <summary>
         /// Pure virtual Update method, all inherited classes must define this
@@ -52,31 +53,107 @@ namespace FieaGameEngine
         /// <param name="worldState"> The current WorldState </param>
         virtual void Update(WorldState* worldState) = 0;
 
+        /// <summary>
+        /// Called once before the first update so that Actions can resolve anything they
+        /// would otherwise look up every update. Does nothing by default.
+        /// </summary>
+        /// <param name="worldState"> The current WorldState </param>
+        virtual void Init(WorldState* worldState);
+
         /// <summary>
         /// Gets the name of this Action
         /// </summary>
         /// <returns> The name of this Action </returns>
-        inline std::string GetName() const { return m_name; };
+        inline const std::string& GetName() const { return m_name; };
 
         /// <summary>
         /// Sets the name of this Action
         /// </summary>
         /// <returns> The name to set this Action to </returns>
-        inline void SetName(const std::string& name) { m_name = name; };
+        void SetName(const std::string& name);
+
+        /// <summary>
+        /// Finds the first Action with the given name in the "Actions" of an Entity or
+        /// ActionList, using the owner's name index. Actions held anywhere else aren't found.
+        /// </summary>
+        /// <param name="owner"> The Scope that holds the Action </param>
+        /// <param name="name"> The name of the Action to find </param>
+        /// <param name="actions"> Set to the owner's "Actions" Datum if the Action is found </param>
+        /// <param name="index"> Set to the Action's index in actions if it is found </param>
+        /// <returns> True if the Action was found, false otherwise </returns>
+        static bool FindByName(Scope& owner, const std::string& name, Datum*& actions, size_t& index);
 
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-        static const Vector<Signature> Signatures();
+        static constexpr std::array<StaticSignature, 1> Signatures()
+        {
+            return std::array<StaticSignature, 1>
+            { {
+                { "Name", Datum::DatumType::String, 1, offsetof(Action, m_name) }
+            } };
+        }
+
+    protected:
+        /// <summary>
+        /// Keeps this Action indexed under its new parent
+        /// </summary>
+        /// <param name="previousParent"> The parent this Action had before </param>
+        void OnParentChanged(Scope* previousParent) override;
 
     private:
+        friend class ActionNameIndex;
+
+        /// <summary>
+        /// Gets the name index of a Scope that can hold Actions
+        /// </summary>
+        /// <param name="owner"> The Scope to get the index of </param>
+        /// <returns> The index, or nullptr if owner isn't an Entity or ActionList </returns>
+        static ActionNameIndex* IndexOf(Scope& owner);
+
+        /// <summary>
+        /// Write hook on the Name attribute that keeps the Action indexed under its new name
+        /// </summary>
+        /// <param name="storage"> The storage of the Name attribute, which is m_name </param>
+        static void OnNameWritten(void* storage, size_t);
+
+        /// <summary>
+        /// Moves this Action to its parent's name index if its parent changed, or under its
+        /// new name if that changed
+        /// </summary>
+        void UpdateIndex();
+
+        /// <summary>
+        /// The index of the Name attribute in our order vector
+        /// </summary>
+        static const size_t m_nameIndex = 1;
+
+        /// <summary>
+        /// The id of the write hook on the Name attribute
+        /// </summary>
+        static const std::uint8_t m_nameWriteHook;
+
         /// <summary>
         /// The name of this Action
         /// </summary>
         std::string m_name;
+
+        /// <summary>
+        /// The name index this Action is in, nullptr if it isn't in one
+        /// </summary>
+        ActionNameIndex* m_indexedIn = nullptr;
+
+        /// <summary>
+        /// The name this Action is indexed under
+        /// </summary>
+        std::string m_indexedName;
+
+        /// <summary>
+        /// The position of this Action in its parent's "Actions" when it was last indexed
+        /// </summary>
+        size_t m_indexedPosition = 0;
     };
 }
-
@@ -19,15 +19,25 @@ namespace FieaGameEngine
     void ActionCreateAction::Update(WorldState* worldState)
     {
         assert(m_parent != nullptr);
-        worldState->AddCreateActionRequest(m_className, m_actionName, *m_parent);
+
+        // The class name can also be changed through its Datum, so check the handle still matches
+        if (m_factory == nullptr || m_factory->ClassName() != m_className)
+        {
+            m_factory = Factory<Scope>::Find(m_className);
+        }
+
+        if (m_factory != nullptr)
+        {
+            worldState->AddCreateActionRequest(*m_factory, m_actionName, *m_parent);
+        }
+        else
+        {
+            worldState->AddCreateActionRequest(m_className, m_actionName, *m_parent);
+        }
     }
 
-    const Vector<Signature> ActionCreateAction::Signatures()
+    void ActionCreateAction::Init(WorldState*)
     {
-        return Vector<Signature>
-        {
-            { "ClassName", Datum::DatumType::String, 1, offsetof(ActionCreateAction, m_className) },
-            { "ActionName", Datum::DatumType::String, 1, offsetof(ActionCreateAction, m_actionName) }
-        };
+        m_factory = Factory<Scope>::Find(m_className);
     }
 }
\ No newline at end of file
@@ -51,7 +51,7 @@ namespace FieaGameEngine
 		/// Sets the name of the class that this action will create
 		/// </summary>
 		/// <param name="className"> The name of the class for this action to create </param>
-		inline void SetClassName(const std::string& className) { m_className = className; }
+		inline void SetClassName(const std::string& className) { m_className = className; m_factory = nullptr; }
 
 		/// <summary>
 		/// Gets the name that the created Action will have
@@ -77,13 +77,27 @@ namespace FieaGameEngine
 		/// <param name="worldState"> The WorldState to queue this create in </param>
         void Update(WorldState* worldState) override;
 
+		/// <summary>
+		/// Resolves the factory of the class this action creates, so that updates don't have
+		/// to look the class name up again
+		/// </summary>
+		/// <param name="worldState"> The current WorldState </param>
+        void Init(WorldState* worldState) override;
+
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-        static const Vector<Signature> Signatures();
+        static constexpr std::array<StaticSignature, 2> Signatures()
+        {
+            return std::array<StaticSignature, 2>
+            { {
+                { "ClassName", Datum::DatumType::String, 1, offsetof(ActionCreateAction, m_className) },
+                { "ActionName", Datum::DatumType::String, 1, offsetof(ActionCreateAction, m_actionName) }
+            } };
+        }
 
 	private:
 		/// <summary>
@@ -95,6 +109,11 @@ namespace FieaGameEngine
 		/// The name to give the Action once it is created
 		/// </summary>
 		std::string m_actionName;
+
+		/// <summary>
+		/// The resolved factory for m_className, nullptr until Init or the first update
+		/// </summary>
+		const Factory<Scope>* m_factory = nullptr;
 	};
 
 	ConcreteFactory(ActionCreateAction, Scope);
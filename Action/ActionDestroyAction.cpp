@@ -22,12 +22,4 @@ namespace FieaGameEngine
         worldState->AddDestroyActionRequest(m_actionName, *m_parent);
     }
 
-    const Vector<Signature> ActionDestroyAction::Signatures()
-    {
-        return Vector<Signature>
-        {
-            { "Action", Datum::DatumType::String, 1, offsetof(ActionDestroyAction, m_actionName) }
-        };
-    }
-
 }
\ No newline at end of file
@@ -71,9 +71,15 @@ namespace FieaGameEngine
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 1> Signatures()
+		{
+			return std::array<StaticSignature, 1>
+			{ {
+				{ "Action", Datum::DatumType::String, 1, offsetof(ActionDestroyAction, m_actionName) }
+			} };
+		}
 
 	private:
         /// <summary>
@@ -2,6 +2,7 @@
 #include "ActionEvent.h"
 #include "EventMessageAttributed.h"
 #include "WorldState.h"
+#include "Entity.h"
 
 namespace FieaGameEngine
 {
@@ -14,40 +15,74 @@ namespace FieaGameEngine
 
     void ActionEvent::Update(WorldState* worldState)
     {
-        EventMessageAttributed e;
-        
-        auto attributes = GetAuxiliaryAttributes();
-        for (PairType* ptr : attributes)
+        // Firing the same attributes again reuses the payload the last message was sent with
+        if (m_payload == nullptr || !IsPayloadCurrent())
         {
-            Datum& newDatum = e.Append(ptr->first);
+            BuildPayload();
+        }
+
+        EventMessageAttributed e;
+        e.SetPayload(m_payload);
+        e.SetSubtype(m_subtype);
+        e.SetWorldState(*worldState);
 
-            if (ptr->second.Type() == Datum::DatumType::Table)
+        // Messages are about the Entity that sent them, so only its own repeats get coalesced
+        for (const Scope* sender = GetParent(); sender != nullptr; sender = sender->GetParent())
+        {
+            if (sender->Is<Entity>())
             {
-                newDatum.SetType(Datum::DatumType::Table);
-                for (size_t i = 0; i < ptr->second.Size(); ++i)
-                {
-                    Scope* newScope = ptr->second.Get<Scope>(i).Clone();
-                    e.Adopt(*newScope, ptr->first);
-                }
+                e.SetTarget(sender);
+                break;
             }
-            else
+        }
+
+        worldState->GetEventQueue().Enqueue(MakeEvent<EventMessageAttributed>(std::move(e)), std::chrono::milliseconds(m_delay));
+    }
+
+    bool ActionEvent::IsPayloadCurrent() const
+    {
+        gsl::span<const PairType> attributes = GetAuxiliaryAttributes();
+        if (attributes.size() != m_payload->Size())
+        {
+            return false;
+        }
+
+        // Keys are unique and the counts match, so every attribute found unchanged means none was added or removed
+        for (const PairType& pair : attributes)
+        {
+            const Datum* datum = m_payload->Find(pair.first);
+            if (datum == nullptr || *datum != pair.second)
             {
-                newDatum = ptr->second;
+                return false;
             }
         }
 
-        e.SetSubtype(m_subtype);
-        e.SetWorldState(*worldState);
-        auto event = std::make_shared<Event<EventMessageAttributed>>(e);
-        worldState->GetEventQueue().Enqueue(event, std::chrono::milliseconds(m_delay));
+        return true;
     }
 
-    const Vector<Signature> ActionEvent::Signatures()
+    void ActionEvent::BuildPayload()
     {
-        return Vector<Signature>
+        gsl::span<const PairType> attributes = GetAuxiliaryAttributes();
+        std::shared_ptr<Scope> payload = std::make_shared<Scope>(attributes.size());
+
+        for (const PairType& pair : attributes)
         {
-            { "Subtype", Datum::DatumType::String, 1, offsetof(ActionEvent, m_subtype) },
-            { "Delay", Datum::DatumType::Integer, 1, offsetof(ActionEvent, m_delay) }
-        };
+            // Adopting may append to the payload, so the appended Datum isn't held on to across it
+            if (pair.second.Type() == Datum::DatumType::Table)
+            {
+                payload->Append(pair.first).SetType(Datum::DatumType::Table);
+                for (size_t i = 0; i < pair.second.Size(); ++i)
+                {
+                    Scope* newScope = pair.second.Get<Scope>(i).Clone();
+                    payload->Adopt(*newScope, pair.first);
+                }
+            }
+            else
+            {
+                payload->Append(pair.first) = pair.second;
+            }
+        }
+
+        m_payload = std::move(payload);
     }
 }
\ No newline at end of file
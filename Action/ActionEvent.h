@@ -1,5 +1,6 @@
 #pragma once
 #include "Action.h"
+#include <memory>
 
 namespace FieaGameEngine
 {
@@ -50,7 +51,8 @@ namespace FieaGameEngine
 
 		/// <summary>
 		/// Update method that creates an EventMessageAttributed, sets its subtype to the 
-		/// subtype of this ActionEvent and then delivers it
+		/// subtype of this ActionEvent and then delivers it. The auxiliary attributes are only
+		/// copied into a new payload when they changed since the last firing.
 		/// </summary>
 		/// <param name="worldState"> The world state to use </param>
 		virtual void Update(WorldState* worldState) override;
@@ -59,9 +61,16 @@ namespace FieaGameEngine
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 2> Signatures()
+		{
+			return std::array<StaticSignature, 2>
+			{ {
+				{ "Subtype", Datum::DatumType::String, 1, offsetof(ActionEvent, m_subtype) },
+				{ "Delay", Datum::DatumType::Integer, 1, offsetof(ActionEvent, m_delay) }
+			} };
+		}
 
 		/// <summary>
 		/// Sets the subtype of this ActionEvent
@@ -86,6 +95,24 @@ namespace FieaGameEngine
 		/// The delay for events that this ActionEvent enqueues
 		/// </summary>
 		int m_delay = 0;
+
+		/// <summary>
+		/// Copy of the auxiliary attributes as of the last firing, shared read-only by every
+		/// message fired since
+		/// </summary>
+		std::shared_ptr<const Scope> m_payload;
+
+		/// <summary>
+		/// Checks whether the payload still matches the auxiliary attributes
+		/// </summary>
+		/// <returns> True if the payload can be sent as is, false otherwise </returns>
+		bool IsPayloadCurrent() const;
+
+		/// <summary>
+		/// Copies the auxiliary attributes into a new payload, leaving the old one to the
+		/// messages still holding it
+		/// </summary>
+		void BuildPayload();
 	};
 
 	ConcreteFactory(ActionEvent, Action);
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "ActionIncrement.h"
+#include "WorldState.h"
 
 namespace FieaGameEngine
 {
@@ -16,25 +17,62 @@ namespace FieaGameEngine
         return new ActionIncrement(*this);
     }
 
-    void ActionIncrement::Update(WorldState*)
+    void ActionIncrement::Init(WorldState*)
     {
-        auto [foundDatum, foundScope] = Search(m_target);
+        m_targetHandle.Resolve(*this, m_target);
+    }
+
+    void ActionIncrement::Update(WorldState* worldState)
+    {
+        Datum* target = m_targetHandle.Resolve(*this, m_target);
 
-        if (foundDatum == nullptr)
+        // Inside a reaction the target may be an attribute of the shared event payload, so write to a private copy of it
+        if (target == nullptr && worldState != nullptr)
+        {
+            const Scope* topScope = worldState->TopScope();
+            if (topScope != nullptr && topScope->Find(m_target) != nullptr)
+            {
+                target = worldState->MutableTopScope().Find(m_target);
+            }
+        }
+
+        if (target == nullptr)
         {
             throw std::exception("Trying to use ActionIncrement on a target that doesn't exist!");
         }
 
-        float currentVal = foundDatum->Front<float>();
-        foundDatum->Set(currentVal + m_step);
-    }
+        size_t size = target->Size();
+        if (size == 0)
+        {
+            return;
+        }
 
-    const Vector<Signature> ActionIncrement::Signatures()
-    {
-        return Vector<Signature>
+        // Work on the raw storage so array targets are incremented in one tight loop
+        switch (target->Type())
+        {
+        case Datum::DatumType::Float:
+        {
+            float* values = &target->Front<float>();
+            for (size_t i = 0; i < size; ++i)
+            {
+                values[i] += m_step;
+            }
+            break;
+        }
+
+        case Datum::DatumType::Integer:
         {
-            { "Target", Datum::DatumType::String, 1, offsetof(ActionIncrement, m_target) },
-            { "Step", Datum::DatumType::Integer, 1, offsetof(ActionIncrement, m_step) }
-        };
+            int* values = &target->Front<int>();
+            int step = static_cast<int>(m_step);
+            for (size_t i = 0; i < size; ++i)
+            {
+                values[i] += step;
+            }
+            break;
+        }
+
+        default:
+            throw std::exception("Trying to use ActionIncrement on a target that isn't a Float or Integer!");
+        }
     }
-}
\ No newline at end of file
+}
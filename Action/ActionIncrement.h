@@ -1,6 +1,7 @@
 #pragma once
 #include "Action.h"
 #include "TypeManager.h"
+#include "DatumHandle.h"
 
 namespace FieaGameEngine
 {
@@ -29,7 +30,7 @@ namespace FieaGameEngine
 		/// Sets the increment target of this Action
 		/// </summary>
 		/// <param name="target"> The new increment target of this Action </param>
-		inline void SetTarget(const std::string& target) { m_target = target; }
+		inline void SetTarget(const std::string& target) { m_target = target; m_targetHandle.Reset(); }
 
 		/// <summary>
 		/// Gets the increment step of this Action
@@ -50,18 +51,36 @@ namespace FieaGameEngine
 		gsl::owner<ActionIncrement*> Clone() const override;
 
 		/// <summary>
-		/// Updates the target by incrementing it by step amount
+		/// Binds the target so Update doesn't have to search for it
 		/// </summary>
 		/// <param name="worldState"> The current world state </param>
+		void Init(WorldState* worldState) override;
+
+		/// <summary>
+		/// Updates the target by incrementing every element of it by step amount. The target is
+		/// only searched for again if the scope tree changed since it was bound. A target that
+		/// isn't in the scope tree is looked for in the event payload being reacted to, which is
+		/// copied before it is written.
+		/// </summary>
+		/// <param name="worldState"> The current world state </param>
+		/// <exception cref="std::exception"> Throws if the target doesn't exist or isn't a
+		/// Float or Integer Datum </exception>
 		void Update(WorldState* worldState) override;
 
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 2> Signatures()
+		{
+			return std::array<StaticSignature, 2>
+			{ {
+				{ "Target", Datum::DatumType::String, 1, offsetof(ActionIncrement, m_target) },
+				{ "Step", Datum::DatumType::Float, 1, offsetof(ActionIncrement, m_step) }
+			} };
+		}
 
 	private:
 		/// <summary>
@@ -73,6 +92,11 @@ namespace FieaGameEngine
 		/// The amount to increment the target by
 		/// </summary>
 		float m_step = 1.0f;
+
+		/// <summary>
+		/// The target Datum, cached between updates
+		/// </summary>
+		DatumHandle m_targetHandle;
 	};
 
 	ConcreteFactory(ActionIncrement, Scope);
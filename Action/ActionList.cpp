@@ -17,17 +17,30 @@ namespace FieaGameEngine
 
     void ActionList::Update(WorldState* worldState)
     {
-        Datum& children = m_order[m_childrenIndex]->second;
+        Datum& children = m_order[m_childrenIndex].second;
 
         for (size_t i = 0; i < children.Size(); ++i)
         {
             Scope* scopeChild = &children.Get<Scope>(i);
-            assert(scopeChild->Is(Action::TypeIdClass()));
+            assert(scopeChild->Is<Action>());
             Action& child = static_cast<Action&>(*scopeChild);
             child.Update(worldState);
         }
     }
 
+    void ActionList::Init(WorldState* worldState)
+    {
+        Datum& children = m_order[m_childrenIndex].second;
+
+        for (size_t i = 0; i < children.Size(); ++i)
+        {
+            Scope* scopeChild = &children.Get<Scope>(i);
+            assert(scopeChild->Is<Action>());
+            Action& child = static_cast<Action&>(*scopeChild);
+            child.Init(worldState);
+        }
+    }
+
 	Action* ActionList::CreateAction(const std::string& className, const std::string& instanceName)
 	{
 		Scope* createdScope = Factory<Scope>::Create(className);
@@ -49,12 +62,4 @@ namespace FieaGameEngine
 		return actionPtr;
 	}
 
-    const Vector<Signature> ActionList::Signatures()
-    {
-        return Vector<Signature>
-        {
-            { "Actions", Datum::DatumType::Table, 0, 0 }
-        };
-    }
-
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "Action.h"
+#include "ActionNameIndex.h"
 namespace FieaGameEngine
 {
 	class ActionList : public Action
@@ -53,6 +54,12 @@ namespace FieaGameEngine
 		/// <param name="worldState"> The current WorldState </param>
 		virtual void Update(WorldState* worldState) override;
 
+		/// <summary>
+		/// Init method that calls init on all nested Actions
+		/// </summary>
+		/// <param name="worldState"> The current WorldState </param>
+		virtual void Init(WorldState* worldState) override;
+
 		/// <summary>
 		/// Creates a new action and adopts into this Actions datum
 		/// </summary>
@@ -60,19 +67,38 @@ namespace FieaGameEngine
 		/// <param name="instanceName"> Name of the action </param>
 		Action* CreateAction(const std::string& className, const std::string& instanceName);
 
+		/// <summary>
+		/// Gets the index of this ActionList's child actions by name
+		/// </summary>
+		/// <returns> The name index of this ActionList's "Actions" </returns>
+		ActionNameIndex& ActionIndex() { return m_actionIndex; }
+
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 1> Signatures()
+		{
+			return std::array<StaticSignature, 1>
+			{ {
+				{ "Actions", Datum::DatumType::Table, 0, 0 }
+			} };
+		}
 
 	private:
+		friend class ActionProgram;
+
 		/// <summary>
 		/// The index of the child actions datum in our order vector
 		/// </summary>
 		static const size_t m_childrenIndex = 2;
+
+		/// <summary>
+		/// The child actions indexed by name, kept current by the actions themselves
+		/// </summary>
+		ActionNameIndex m_actionIndex{ m_childrenIndex };
 	};
 
 }
@@ -19,37 +19,45 @@ namespace FieaGameEngine
     {
         if (m_condition)
         {
-            Datum& thenActions = m_order[m_thenIndex]->second;
+            Datum& thenActions = m_order[m_thenIndex].second;
 
             for (size_t i = 0; i < thenActions.Size(); ++i)
             {
                 Scope* scopeChild = &thenActions.Get<Scope>(i);
-                assert(scopeChild->Is(Action::TypeIdClass()));
+                assert(scopeChild->Is<Action>());
                 Action& child = static_cast<Action&>(*scopeChild);
                 child.Update(worldState);
             }
         }
         else
         {
-            Datum& elseActions = m_order[m_elseIndex]->second;
+            Datum& elseActions = m_order[m_elseIndex].second;
 
             for (size_t i = 0; i < elseActions.Size(); ++i)
             {
                 Scope* scopeChild = &elseActions.Get<Scope>(i);
-                assert(scopeChild->Is(Action::TypeIdClass()));
+                assert(scopeChild->Is<Action>());
                 Action& child = static_cast<Action&>(*scopeChild);
                 child.Update(worldState);
             }
         }
     }
 
-
-    const Vector<Signature> ActionListIf::Signatures()
+    void ActionListIf::Init(WorldState* worldState)
     {
-        return Vector<Signature>
+        auto initActions = [worldState](Datum& actions)
         {
-            { "Then", Datum::DatumType::Table, 0, 0 },
-            { "Else", Datum::DatumType::Table, 0, 0 }
+            for (size_t i = 0; i < actions.Size(); ++i)
+            {
+                Scope* scopeChild = &actions.Get<Scope>(i);
+                assert(scopeChild->Is<Action>());
+                Action& child = static_cast<Action&>(*scopeChild);
+                child.Init(worldState);
+            }
         };
+
+        initActions(m_order[m_thenIndex].second);
+        initActions(m_order[m_elseIndex].second);
     }
+
 }
\ No newline at end of file
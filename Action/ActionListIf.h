@@ -69,13 +69,29 @@ namespace FieaGameEngine
         /// <param name="worldState"></param>
         void Update(WorldState * worldState) override;
 
+        /// <summary>
+        /// Init function that calls init on all of the nested actions in both the
+        /// Then datum and the Else datum, since the condition may change later
+        /// </summary>
+        /// <param name="worldState"> The current WorldState </param>
+        void Init(WorldState* worldState) override;
+
         /// <summary>
         /// Update method that queues this creation with the passed in world state
         /// </summary>
         /// <param name="worldState"> The WorldState to queue this create in </param>
-        static const Vector<Signature> Signatures();
+        static constexpr std::array<StaticSignature, 2> Signatures()
+        {
+            return std::array<StaticSignature, 2>
+            { {
+                { "Then", Datum::DatumType::Table, 0, 0 },
+                { "Else", Datum::DatumType::Table, 0, 0 }
+            } };
+        }
 
     private:
+        friend class ActionProgram;
+
         /// <summary>
         /// The condition that determines if this Action runs the Then or Else actions
         /// </summary>
@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "ActionNameIndex.h"
+#include "Action.h"
+
+namespace FieaGameEngine
+{
+    ActionNameIndex::ActionNameIndex(size_t actionsIndex)
+        : m_actionsIndex(actionsIndex)
+    {
+    }
+
+    ActionNameIndex::ActionNameIndex(const ActionNameIndex& other)
+        : m_actionsIndex(other.m_actionsIndex)
+    {
+    }
+
+    ActionNameIndex::ActionNameIndex(ActionNameIndex&& other) noexcept
+        : m_actionsIndex(other.m_actionsIndex)
+    {
+        other.Invalidate();
+    }
+
+    ActionNameIndex& ActionNameIndex::operator=(const ActionNameIndex& other)
+    {
+        if (this != &other)
+        {
+            Invalidate();
+            m_actionsIndex = other.m_actionsIndex;
+        }
+
+        return *this;
+    }
+
+    ActionNameIndex& ActionNameIndex::operator=(ActionNameIndex&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Invalidate();
+            m_actionsIndex = other.m_actionsIndex;
+            other.Invalidate();
+        }
+
+        return *this;
+    }
+
+    ActionNameIndex::~ActionNameIndex()
+    {
+        Invalidate();
+    }
+
+    void ActionNameIndex::Invalidate()
+    {
+        for (auto& [name, actions] : m_actions)
+        {
+            for (Action* action : actions)
+            {
+                action->m_indexedIn = nullptr;
+            }
+        }
+
+        m_actions.Clear();
+        m_owner = nullptr;
+    }
+
+    bool ActionNameIndex::Find(Scope& owner, const std::string& name, Datum*& actions, size_t& position)
+    {
+        if (!IsBuilt())
+        {
+            Build(owner);
+        }
+
+        assert(m_owner == &owner);
+
+        auto it = m_actions.Find(name);
+        if (it == m_actions.end())
+        {
+            return false;
+        }
+
+        // Names are rarely shared, but when they are the first one in the Datum wins
+        const Action* first = it->second.Front();
+        for (const Action* action : it->second)
+        {
+            if (action->m_indexedPosition < first->m_indexedPosition)
+            {
+                first = action;
+            }
+        }
+
+        actions = Actions();
+        position = first->m_indexedPosition;
+        return true;
+    }
+
+    void ActionNameIndex::Build(Scope& owner)
+    {
+        m_owner = &owner;
+
+        Datum* actions = Actions();
+        if (actions == nullptr)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < actions->Size(); ++i)
+        {
+            Action* action = actions->Get<Scope>(i).As<Action>();
+            if (action != nullptr)
+            {
+                Insert(*action, i);
+            }
+        }
+    }
+
+    void ActionNameIndex::Add(Action& action)
+    {
+        if (!IsBuilt())
+        {
+            return;
+        }
+
+        Datum* actions = Actions();
+        if (actions == nullptr)
+        {
+            Invalidate();
+            return;
+        }
+
+        // A moved Action takes the other's position, an adopted one is appended
+        size_t position = action.m_indexedPosition;
+        if (position < actions->Size() && &actions->Get<Scope>(position) == &action)
+        {
+            Insert(action, position);
+        }
+        else if (actions->Size() > 0 && &actions->Back<Scope>() == &action)
+        {
+            Insert(action, actions->Size() - 1);
+        }
+        else
+        {
+            Invalidate();
+        }
+    }
+
+    void ActionNameIndex::Remove(Action& action)
+    {
+        Erase(action);
+        action.m_indexedIn = nullptr;
+
+        Datum* actions = Actions();
+        if (actions == nullptr)
+        {
+            return;
+        }
+
+        // An Action deleted in place, as Clear does, leaves everything else where it was
+        size_t position = action.m_indexedPosition;
+        if (position < actions->Size() && &actions->Get<Scope>(position) == &action)
+        {
+            return;
+        }
+
+        // Otherwise it was removed from the Datum, and everything after it shifted down by one
+        for (size_t i = position; i < actions->Size(); ++i)
+        {
+            Action* shifted = actions->Get<Scope>(i).As<Action>();
+            if (shifted != nullptr && shifted->m_indexedIn == this)
+            {
+                shifted->m_indexedPosition = i;
+            }
+        }
+    }
+
+    void ActionNameIndex::Rename(Action& action)
+    {
+        if (action.m_indexedName != action.GetName())
+        {
+            Erase(action);
+            Insert(action, action.m_indexedPosition);
+        }
+    }
+
+    void ActionNameIndex::Insert(Action& action, size_t position)
+    {
+        action.m_indexedIn = this;
+        action.m_indexedName = action.GetName();
+        action.m_indexedPosition = position;
+        m_actions[action.m_indexedName].PushBack(&action);
+    }
+
+    void ActionNameIndex::Erase(Action& action)
+    {
+        auto it = m_actions.Find(action.m_indexedName);
+        if (it == m_actions.end())
+        {
+            return;
+        }
+
+        it->second.Remove(&action);
+        if (it->second.IsEmpty())
+        {
+            m_actions.Remove(action.m_indexedName);
+        }
+    }
+
+    Datum* ActionNameIndex::Actions() const
+    {
+        if (m_owner == nullptr || m_owner->Size() <= m_actionsIndex)
+        {
+            return nullptr;
+        }
+
+        Datum& actions = (*m_owner)[m_actionsIndex];
+        return (actions.Type() == Datum::DatumType::Table) ? &actions : nullptr;
+    }
+}
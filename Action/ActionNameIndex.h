@@ -0,0 +1,144 @@
+#pragma once
+#include <string>
+#include "HashMap.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+    class Action;
+    class Datum;
+    class Scope;
+
+    /// <summary>
+    /// Index from name to position of the Actions a Scope holds in its "Actions" Datum. Entity
+    /// and ActionList each own one. It is built by the first lookup, and from then on the
+    /// Actions keep it current themselves as they are adopted, orphaned, renamed or destroyed,
+    /// so a lookup never compares names or scans the Datum. A copied or moved index starts
+    /// unbuilt, since the Actions it would hold belong to another Scope.
+    /// </summary>
+    class ActionNameIndex final
+    {
+    public:
+        /// <summary>
+        /// Constructs an unbuilt index
+        /// </summary>
+        /// <param name="actionsIndex"> The slot of the "Actions" Datum in its owner </param>
+        explicit ActionNameIndex(size_t actionsIndex);
+
+        /// <summary>
+        /// Copy constructor. The copy belongs to a different Scope, so it starts unbuilt.
+        /// </summary>
+        /// <param name="other"> The index to copy </param>
+        ActionNameIndex(const ActionNameIndex& other);
+
+        /// <summary>
+        /// Move constructor. The new index belongs to a different Scope, so it starts unbuilt.
+        /// </summary>
+        /// <param name="other"> The index to move </param>
+        ActionNameIndex(ActionNameIndex&& other) noexcept;
+
+        /// <summary>
+        /// Copy assignment. The owner's Actions are being replaced, so this becomes unbuilt.
+        /// </summary>
+        /// <param name="other"> The index to copy </param>
+        ActionNameIndex& operator=(const ActionNameIndex& other);
+
+        /// <summary>
+        /// Move assignment. The owner's Actions are being replaced, so this becomes unbuilt.
+        /// </summary>
+        /// <param name="other"> The index to move </param>
+        ActionNameIndex& operator=(ActionNameIndex&& other) noexcept;
+
+        /// <summary>
+        /// Destructor that detaches every indexed Action
+        /// </summary>
+        ~ActionNameIndex();
+
+        /// <summary>
+        /// Checks if the index has been built and is being kept current
+        /// </summary>
+        /// <returns> True if it is built, false otherwise </returns>
+        bool IsBuilt() const { return m_owner != nullptr; }
+
+        /// <summary>
+        /// Detaches every indexed Action and marks the index unbuilt, so the next lookup
+        /// rebuilds it
+        /// </summary>
+        void Invalidate();
+
+    private:
+        friend class Action;
+
+        /// <summary>
+        /// Finds the first Action in the owner's "Actions" Datum with the given name, building
+        /// the index first if it isn't built
+        /// </summary>
+        /// <param name="owner"> The Scope this index belongs to </param>
+        /// <param name="name"> The name to look for </param>
+        /// <param name="actions"> Set to the owner's "Actions" Datum if the Action is found </param>
+        /// <param name="position"> Set to the Action's position in actions if it is found </param>
+        /// <returns> True if the Action was found, false otherwise </returns>
+        bool Find(Scope& owner, const std::string& name, Datum*& actions, size_t& position);
+
+        /// <summary>
+        /// Indexes every Action in the owner's "Actions" Datum
+        /// </summary>
+        /// <param name="owner"> The Scope this index belongs to </param>
+        void Build(Scope& owner);
+
+        /// <summary>
+        /// Indexes an Action that was just adopted by or moved into the owner. Adopting appends
+        /// and moving keeps the position the Action was last indexed at, so anything found at
+        /// neither was placed some other way, and the index is invalidated rather than searched.
+        /// </summary>
+        /// <param name="action"> The adopted Action </param>
+        void Add(Action& action);
+
+        /// <summary>
+        /// Removes an Action and renumbers the Actions that shifted down into its position
+        /// </summary>
+        /// <param name="action"> The Action to remove </param>
+        void Remove(Action& action);
+
+        /// <summary>
+        /// Moves an Action under the name its Name attribute now holds
+        /// </summary>
+        /// <param name="action"> The renamed Action </param>
+        void Rename(Action& action);
+
+        /// <summary>
+        /// Records an Action under its current name at the given position
+        /// </summary>
+        /// <param name="action"> The Action to record </param>
+        /// <param name="position"> Its position in the owner's "Actions" Datum </param>
+        void Insert(Action& action, size_t position);
+
+        /// <summary>
+        /// Removes an Action from the list of the name it was recorded under
+        /// </summary>
+        /// <param name="action"> The Action to erase </param>
+        void Erase(Action& action);
+
+        /// <summary>
+        /// Gets the owner's "Actions" Datum
+        /// </summary>
+        /// <returns> The Datum, or nullptr if the owner doesn't hold one at the expected slot,
+        /// which happens while it is being moved from or assigned to </returns>
+        Datum* Actions() const;
+
+        /// <summary>
+        /// Every indexed Action, grouped by the name it was recorded under
+        /// </summary>
+        HashMap<std::string, Vector<Action*>> m_actions;
+
+        /// <summary>
+        /// The Scope the index was built for, nullptr while unbuilt
+        /// </summary>
+        Scope* m_owner = nullptr;
+
+        /// <summary>
+        /// The slot of the "Actions" Datum in the owner
+        /// </summary>
+        size_t m_actionsIndex;
+    };
+}
@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "ActionProgram.h"
+#include "ActionList.h"
+#include "ActionListIf.h"
+
+namespace FieaGameEngine
+{
+    ActionProgram::ActionProgram(const ActionProgram&)
+    {
+    }
+
+    ActionProgram& ActionProgram::operator=(const ActionProgram& other)
+    {
+        if (this != &other)
+        {
+            Invalidate();
+        }
+
+        return *this;
+    }
+
+    void ActionProgram::Compile(Datum& actions)
+    {
+        m_instructions.Clear();
+        CompileActions(actions);
+        m_isCompiled = true;
+    }
+
+    void ActionProgram::Run(WorldState* worldState) const
+    {
+        assert(m_isCompiled);
+
+        size_t programCounter = 0;
+        while (programCounter < m_instructions.Size())
+        {
+            const Instruction& instruction = m_instructions[programCounter];
+
+            switch (instruction.m_opCode)
+            {
+            case OpCode::Update:
+                instruction.m_action->Update(worldState);
+                ++programCounter;
+                break;
+
+            case OpCode::BranchIfFalse:
+                programCounter = (*instruction.m_condition) ? programCounter + 1 : instruction.m_target;
+                break;
+
+            case OpCode::Jump:
+                programCounter = instruction.m_target;
+                break;
+            }
+        }
+    }
+
+    void ActionProgram::Invalidate()
+    {
+        m_instructions.Clear();
+        m_isCompiled = false;
+    }
+
+    void ActionProgram::CompileActions(Datum& actions)
+    {
+        for (size_t i = 0; i < actions.Size(); ++i)
+        {
+            Scope* scopeChild = &actions.Get<Scope>(i);
+            assert(scopeChild->Is<Action>());
+            CompileAction(static_cast<Action&>(*scopeChild));
+        }
+    }
+
+    void ActionProgram::CompileAction(Action& action)
+    {
+        // Only plain ActionLists are inlined, derived lists such as Reactions override Update
+        if (action.TypeIdInstance() == ActionList::TypeIdClass())
+        {
+            ActionList& actionList = static_cast<ActionList&>(action);
+            CompileActions(actionList.m_order[ActionList::m_childrenIndex].second);
+        }
+        else if (action.TypeIdInstance() == ActionListIf::TypeIdClass())
+        {
+            ActionListIf& actionListIf = static_cast<ActionListIf&>(action);
+
+            size_t branch = Emit(OpCode::BranchIfFalse);
+            m_instructions[branch].m_condition = &actionListIf.m_condition;
+            CompileActions(actionListIf.m_order[ActionListIf::m_thenIndex].second);
+
+            size_t jump = Emit(OpCode::Jump);
+            m_instructions[branch].m_target = static_cast<std::uint32_t>(m_instructions.Size());
+            CompileActions(actionListIf.m_order[ActionListIf::m_elseIndex].second);
+            m_instructions[jump].m_target = static_cast<std::uint32_t>(m_instructions.Size());
+        }
+        else
+        {
+            size_t update = Emit(OpCode::Update);
+            m_instructions[update].m_action = &action;
+        }
+    }
+
+    size_t ActionProgram::Emit(OpCode opCode)
+    {
+        Instruction instruction;
+        instruction.m_opCode = opCode;
+        instruction.m_target = 0;
+        instruction.m_action = nullptr;
+
+        m_instructions.PushBack(instruction);
+        return m_instructions.Size() - 1;
+    }
+}
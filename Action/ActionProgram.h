@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+    class WorldState;
+    class Action;
+    class Datum;
+
+    /// <summary>
+    /// An action tree flattened into a linear list of instructions. ActionLists are inlined and
+    /// ActionListIfs become a conditional branch over their Then instructions and a jump over
+    /// their Else instructions, so running the program is a single loop with no Datum lookups
+    /// or type checks. Every other action is kept as a direct Update call on the resolved
+    /// Action pointer. A program holds raw pointers into the tree it was compiled from, so its
+    /// owner must invalidate it whenever that tree structurally changes; Entity is told by its
+    /// Actions whenever one is adopted, orphaned, moved or destroyed.
+    /// </summary>
+    class ActionProgram final
+    {
+    public:
+        /// <summary>
+        /// What an instruction does
+        /// </summary>
+        enum class OpCode : std::uint8_t
+        {
+            Update,
+            BranchIfFalse,
+            Jump
+        };
+
+        /// <summary>
+        /// One compiled instruction
+        /// </summary>
+        struct Instruction
+        {
+            /// <summary>
+            /// What this instruction does
+            /// </summary>
+            OpCode m_opCode;
+
+            /// <summary>
+            /// Where BranchIfFalse and Jump continue from
+            /// </summary>
+            std::uint32_t m_target;
+
+            union
+            {
+                /// <summary>
+                /// The action an Update instruction calls
+                /// </summary>
+                Action* m_action;
+
+                /// <summary>
+                /// The condition a BranchIfFalse instruction tests
+                /// </summary>
+                const int* m_condition;
+            };
+        };
+
+        ActionProgram() = default;
+
+        /// <summary>
+        /// Copy constructor. A copy belongs to a different tree, so it starts uncompiled.
+        /// </summary>
+        /// <param name="other"> The program to copy </param>
+        ActionProgram(const ActionProgram& other);
+
+        /// <summary>
+        /// Default move constructor
+        /// </summary>
+        /// <param name="other"> The program to move </param>
+        ActionProgram(ActionProgram&& other) = default;
+
+        /// <summary>
+        /// Copy assignment. A copy belongs to a different tree, so it becomes uncompiled.
+        /// </summary>
+        /// <param name="other"> The program to copy </param>
+        ActionProgram& operator=(const ActionProgram& other);
+
+        /// <summary>
+        /// Default move assignment
+        /// </summary>
+        /// <param name="other"> The program to move </param>
+        ActionProgram& operator=(ActionProgram&& other) = default;
+
+        ~ActionProgram() = default;
+
+        /// <summary>
+        /// Compiles a datum of actions, replacing whatever was compiled before
+        /// </summary>
+        /// <param name="actions"> The Table datum of actions to compile </param>
+        void Compile(Datum& actions);
+
+        /// <summary>
+        /// Runs the compiled instructions in order
+        /// </summary>
+        /// <param name="worldState"> The current WorldState </param>
+        void Run(WorldState* worldState) const;
+
+        /// <summary>
+        /// Throws the compiled instructions away so the next user recompiles
+        /// </summary>
+        void Invalidate();
+
+        /// <summary>
+        /// Checks if the program is compiled and in step with its tree
+        /// </summary>
+        /// <returns> True if it is compiled, false otherwise </returns>
+        bool IsCompiled() const { return m_isCompiled; }
+
+        /// <summary>
+        /// Gets the compiled instructions
+        /// </summary>
+        /// <returns> The compiled instructions </returns>
+        const Vector<Instruction>& Instructions() const { return m_instructions; }
+
+    private:
+        /// <summary>
+        /// Appends the instructions for each action in a datum
+        /// </summary>
+        /// <param name="actions"> The Table datum of actions to append </param>
+        void CompileActions(Datum& actions);
+
+        /// <summary>
+        /// Appends the instructions for a single action
+        /// </summary>
+        /// <param name="action"> The action to append </param>
+        void CompileAction(Action& action);
+
+        /// <summary>
+        /// Appends an instruction and returns its index so its target can be patched later
+        /// </summary>
+        /// <param name="opCode"> What the instruction does </param>
+        /// <returns> The index of the new instruction </returns>
+        size_t Emit(OpCode opCode);
+
+        /// <summary>
+        /// The compiled instructions
+        /// </summary>
+        Vector<Instruction> m_instructions;
+
+        /// <summary>
+        /// Whether the instructions are in step with the tree
+        /// </summary>
+        bool m_isCompiled = false;
+    };
+}
@@ -7,15 +7,87 @@ namespace FieaGameEngine
 {
     RTTI_DEFINITIONS(ReactionAttributed);
 
+    HashMap<std::string, Vector<ReactionAttributed*>> ReactionAttributed::m_subtypeIndex;
+    Vector<ReactionAttributed*> ReactionAttributed::m_pendingAdditions;
+    size_t ReactionAttributed::m_dispatchDepth = 0;
+    bool ReactionAttributed::m_hasTombstones = false;
+    std::mutex ReactionAttributed::m_indexMutex;
+    ReactionAttributed::SubtypeDispatcher ReactionAttributed::m_dispatcher;
+
     ReactionAttributed::ReactionAttributed(const std::string& subtype)
         : Reaction(ReactionAttributed::TypeIdClass()), m_subtype(subtype)
     {
-        Event<EventMessageAttributed>::Subscribe(*this);
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        AddToIndex();
+    }
+
+    ReactionAttributed::ReactionAttributed(const ReactionAttributed& other)
+        : Reaction(other), m_subtype(other.m_subtype)
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        AddToIndex();
+    }
+
+    ReactionAttributed::ReactionAttributed(ReactionAttributed&& other)
+        : Reaction(std::move(other)), m_subtype(std::move(other.m_subtype))
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        AddToIndex();
+    }
+
+    ReactionAttributed& ReactionAttributed::operator=(const ReactionAttributed& other)
+    {
+        if (this != &other)
+        {
+            Reaction::operator=(other);
+            m_subtype = other.m_subtype;
+
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            UpdateIndex();
+        }
+
+        return *this;
+    }
+
+    ReactionAttributed& ReactionAttributed::operator=(ReactionAttributed&& other)
+    {
+        if (this != &other)
+        {
+            Reaction::operator=(std::move(other));
+            m_subtype = std::move(other.m_subtype);
+
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            UpdateIndex();
+        }
+
+        return *this;
     }
 
     ReactionAttributed::~ReactionAttributed()
     {
-        Event<EventMessageAttributed>::Unsubscribe(*this);
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        RemoveFromIndex();
+    }
+
+    void ReactionAttributed::Init(WorldState* worldState)
+    {
+        Reaction::Init(worldState);
+
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        UpdateIndex();
+    }
+
+    void ReactionAttributed::SetSubtype(const std::string& subtype)
+    {
+        m_subtype = subtype;
+
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        UpdateIndex();
+    }
+
+    void ReactionAttributed::SubscribeDispatcher()
+    {
+        Event<EventMessageAttributed>::Subscribe(m_dispatcher);
     }
 
     void ReactionAttributed::Notify(const EventPublisher& event)
@@ -28,42 +100,161 @@ namespace FieaGameEngine
         // if it matches the subtype of this reaction attributed
         if (message.GetSubtype() == m_subtype)
         {
+            React(message);
+        }
+    }
 
-            // Make a copy of auxiliary attributes
-            Scope scope;
-            auto attributes = message.GetAuxiliaryAttributes();
-            for (PairType* ptr : attributes)
+    void ReactionAttributed::SubtypeDispatcher::Notify(const EventPublisher& event)
+    {
+        // assume the event publisher is event message attributed
+        const Event<EventMessageAttributed>* castedEvent = event.As<Event<EventMessageAttributed>>();
+        assert(castedEvent != nullptr);
+        const EventMessageAttributed& message = castedEvent->Message();
+
+        // Reacting may create, destroy or re-subtype reactions. While we dispatch those changes
+        // are deferred or tombstoned, so the bucket neither moves nor shifts under us.
+        Vector<ReactionAttributed*>* reactions = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_indexMutex);
+            auto it = m_subtypeIndex.Find(message.GetSubtype());
+            if (it == m_subtypeIndex.end())
+            {
+                return;
+            }
+
+            reactions = &it->second;
+            ++m_dispatchDepth;
+        }
+
+        struct DispatchGuard
+        {
+            ~DispatchGuard()
             {
-                Datum& newDatum = scope.Append(ptr->first);
+                std::lock_guard<std::mutex> lock(m_indexMutex);
+                EndDispatch();
+            }
+        } dispatchGuard;
 
-                if (ptr->second.Type() == Datum::DatumType::Table)
+        for (size_t i = 0; ; ++i)
+        {
+            ReactionAttributed* reaction = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(m_indexMutex);
+                if (i >= reactions->Size())
                 {
-                    newDatum.SetType(Datum::DatumType::Table);
-                    for (size_t i = 0; i < ptr->second.Size(); ++i)
-                    {
-                        Scope* newScope = ptr->second.Get<Scope>(i).Clone();
-                        scope.Adopt(*newScope, ptr->first);
-                    }
+                    break;
+                }
+
+                reaction = (*reactions)[i];
+            }
+
+            // Skip tombstones, and reactions whose Subtype attribute was written since they were indexed
+            if (reaction != nullptr && reaction->m_subtype == reaction->m_indexedSubtype)
+            {
+                reaction->React(message);
+            }
+        }
+    }
+
+    void ReactionAttributed::React(const EventMessageAttributed& message)
+    {
+        // The payload is shared by every reaction it is delivered to, so push it read-only rather
+        // than copying its attributes. Anything that writes to it gets its own copy.
+        WorldState* worldState = message.GetWorldState();
+        const Scope* payload = message.GetPayload();
+        worldState->PushScope((payload != nullptr) ? *payload : message);
+        ActionList::Update(worldState);
+        worldState->PopScope();
+    }
+
+    void ReactionAttributed::AddToIndex()
+    {
+        m_indexedSubtype = m_subtype;
+        if (m_dispatchDepth > 0)
+        {
+            m_pendingAdditions.PushBack(this);
+        }
+        else
+        {
+            m_subtypeIndex[m_indexedSubtype].PushBack(this);
+        }
+    }
+
+    void ReactionAttributed::RemoveFromIndex()
+    {
+        auto it = m_subtypeIndex.Find(m_indexedSubtype);
+        if (it != m_subtypeIndex.end())
+        {
+            Vector<ReactionAttributed*>& reactions = it->second;
+            auto reactionIt = reactions.Find(this);
+            if (reactionIt != reactions.end())
+            {
+                if (m_dispatchDepth > 0)
+                {
+                    *reactionIt = nullptr;
+                    m_hasTombstones = true;
                 }
                 else
                 {
-                    newDatum = ptr->second;
+                    reactions.Remove(reactionIt);
+                    if (reactions.IsEmpty())
+                    {
+                        m_subtypeIndex.Remove(m_indexedSubtype);
+                    }
                 }
+
+                return;
             }
+        }
+
+        m_pendingAdditions.Remove(this);
+    }
 
-            // Push the copied attributes onto the stack and call update
-            WorldState* worldState = message.GetWorldState();
-            worldState->m_scopeStack.Push(&scope);
-            ActionList::Update(worldState);
-            worldState->m_scopeStack.Pop();
+    void ReactionAttributed::UpdateIndex()
+    {
+        if (m_subtype != m_indexedSubtype)
+        {
+            RemoveFromIndex();
+            AddToIndex();
         }
     }
 
-    const Vector<Signature> ReactionAttributed::Signatures()
+    void ReactionAttributed::EndDispatch()
     {
-        return Vector<Signature>
+        if (--m_dispatchDepth > 0)
         {
-            { "Subtype", Datum::DatumType::String, 1, offsetof(ReactionAttributed, m_subtype) }
-        };
+            return;
+        }
+
+        for (ReactionAttributed* reaction : m_pendingAdditions)
+        {
+            m_subtypeIndex[reaction->m_indexedSubtype].PushBack(reaction);
+        }
+        m_pendingAdditions.Clear();
+
+        if (!m_hasTombstones)
+        {
+            return;
+        }
+
+        Vector<std::string> emptySubtypes;
+        for (auto& [subtype, reactions] : m_subtypeIndex)
+        {
+            while (reactions.Remove(nullptr))
+            {
+            }
+
+            if (reactions.IsEmpty())
+            {
+                emptySubtypes.PushBack(subtype);
+            }
+        }
+
+        for (const std::string& subtype : emptySubtypes)
+        {
+            m_subtypeIndex.Remove(subtype);
+        }
+
+        m_hasTombstones = false;
     }
-}
\ No newline at end of file
+}
@@ -1,11 +1,17 @@
 #pragma once
 #include "Reaction.h"
 #include "Factory.h"
+#include "HashMap.h"
+#include <mutex>
 
 namespace FieaGameEngine
 {
+	class EventMessageAttributed;
+
 	/// <summary>
-	/// Reaction Attributed class that allows creating reactions through JSON
+	/// Reaction Attributed class that allows creating reactions through JSON. Rather than every
+	/// instance subscribing to attributed events, one shared dispatcher subscribes
+	/// and hands each message straight to the reactions indexed under its subtype.
 	/// </summary>
 	class ReactionAttributed : public Reaction
 	{
@@ -13,50 +19,66 @@ namespace FieaGameEngine
 
 	public:
 		/// <summary>
-		/// Default constructor that subscribes this ReactionAttributed to events
-		/// of type EventMessageAttributed
+		/// Default constructor that adds this ReactionAttributed to the subtype index, so it
+		/// receives events of type EventMessageAttributed with a matching subtype
 		/// </summary>
 		/// <param name="subtype"> Optional parameter that defines the subtype of
 		/// this ReactionAttributed </param>
 		explicit ReactionAttributed(const std::string& subtype = "");
 
         /// <summary>
-        /// Default copy constructor
+        /// Copy constructor that adds the copy to the subtype index
         /// </summary>
         /// <param name=""> The other ReactionAttributed to copy from </param>
-		ReactionAttributed(const ReactionAttributed& other) = default;
+		ReactionAttributed(const ReactionAttributed& other);
 
         /// <summary>
-        /// Default move constructor
+        /// Move constructor that adds the new ReactionAttributed to the subtype index
         /// </summary>
         /// <param name=""> The other ReactionAttributed to move from </param>
-		ReactionAttributed(ReactionAttributed&& other) = default;
+		ReactionAttributed(ReactionAttributed&& other);
 
         /// <summary>
-        /// Default copy assignment
+        /// Copy assignment that moves this ReactionAttributed to the other's subtype
         /// </summary>
         /// <param name=""> The other ReactionAttributed to copy from </param>
         /// <returns> A reference to this ReactionAttributed </returns>
-		ReactionAttributed& operator=(const ReactionAttributed& other) = default;
+		ReactionAttributed& operator=(const ReactionAttributed& other);
 
         /// <summary>
-        /// Default move assignment
+        /// Move assignment that moves this ReactionAttributed to the other's subtype
         /// </summary>
         /// <param name=""> The other ReactionAttributed to move from </param>
         /// <returns> A reference to this ReactionAttributed </returns>
-		ReactionAttributed& operator=(ReactionAttributed&& other) = default;
+		ReactionAttributed& operator=(ReactionAttributed&& other);
 
 		/// <summary>
-		/// Default destructor that unsubscribes this ReactionAttributed from
-		/// events of type EventMessageAttributed
+		/// Destructor that removes this ReactionAttributed from the subtype index
 		/// </summary>
 		~ReactionAttributed();
 
+		/// <summary>
+		/// Init method that calls init on all nested Actions, then re-indexes this
+		/// ReactionAttributed in case its Subtype attribute was written directly, such as
+		/// by the JSON parser
+		/// </summary>
+		/// <param name="worldState"> The current WorldState </param>
+		virtual void Init(WorldState* worldState) override;
+
+		/// <summary>
+		/// Subscribes the shared dispatcher to attributed events. Reactions never subscribe
+		/// themselves, since parallel Scope copies construct and destroy them on worker threads
+		/// and the subscriber list isn't thread safe, so this must be called once on the main
+		/// thread before any attributed event is delivered. WorldState does so on construction.
+		/// </summary>
+		static void SubscribeDispatcher();
+
 		/// <summary>
 		/// Handles the case where an event we are subscribed to is delivered. 
 		/// In this case, specifically looks for EventMessageAttributed and checks its
 		/// subtype against our own, calling update on our contained ActionList if there
-		/// is a match
+		/// is a match. Only used when a ReactionAttributed is subscribed by hand, since
+		/// the subtype index already delivers matching messages.
 		/// </summary>
 		/// <param name="event"></param>
 		void Notify(const EventPublisher& event) override;
@@ -67,19 +89,116 @@ namespace FieaGameEngine
 		/// <returns> The subtype of this ReactionAttributed </returns>
 		const std::string& GetSubtype() const { return m_subtype; }
 
+		/// <summary>
+		/// Sets the subtype of this ReactionAttributed and moves it in the subtype index
+		/// </summary>
+		/// <param name="subtype"> The subtype to set this ReactionAttributed to </param>
+		void SetSubtype(const std::string& subtype);
+
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-        static const Vector<Signature> Signatures();
+        static constexpr std::array<StaticSignature, 1> Signatures()
+        {
+            return std::array<StaticSignature, 1>
+            { {
+                { "Subtype", Datum::DatumType::String, 1, offsetof(ReactionAttributed, m_subtype) }
+            } };
+        }
 
 	private:
+		/// <summary>
+		/// The single subscriber to attributed events that looks up the
+		/// reactions for each message's subtype
+		/// </summary>
+		class SubtypeDispatcher final : public EventSubscriber
+		{
+		public:
+			/// <summary>
+			/// Delivers the message to every ReactionAttributed indexed under its subtype
+			/// </summary>
+			/// <param name="event"> The event being received </param>
+			void Notify(const EventPublisher& event) override;
+		};
+
+		/// <summary>
+		/// Calls update on our contained ActionList with the message pushed onto the scope
+		/// stack as a read-only Scope
+		/// </summary>
+		/// <param name="message"> The message to react to </param>
+		void React(const EventMessageAttributed& message);
+
+		/// <summary>
+		/// Adds this ReactionAttributed to the index under its current subtype. While a message is being
+		/// dispatched the addition is deferred until the dispatch ends. Must be called with
+		/// m_indexMutex held.
+		/// </summary>
+		void AddToIndex();
+
+		/// <summary>
+		/// Removes this ReactionAttributed from the index. While a message is being dispatched its entry is
+		/// tombstoned instead of erased. Must be called with m_indexMutex held.
+		/// </summary>
+		void RemoveFromIndex();
+
+		/// <summary>
+		/// Moves this ReactionAttributed in the index if its subtype has changed. Must be
+		/// called with m_indexMutex held.
+		/// </summary>
+		void UpdateIndex();
+
+		/// <summary>
+		/// Marks the end of a dispatch. The last one to end adds the deferred reactions and
+		/// sweeps out tombstones and empty subtypes. Must be called with m_indexMutex held.
+		/// </summary>
+		static void EndDispatch();
+
 		/// <summary>
 		/// The subtype of this ReactionAttributed
 		/// </summary>
 		std::string m_subtype;
+
+		/// <summary>
+		/// The subtype this ReactionAttributed is currently indexed under, which lags behind
+		/// m_subtype if the Subtype attribute is written directly until the next Init
+		/// </summary>
+		std::string m_indexedSubtype;
+
+		/// <summary>
+		/// Every indexed ReactionAttributed, keyed by subtype. Removed reactions are left as
+		/// nullptr tombstones while a message is being dispatched, and subtypes are dropped
+		/// once their last reaction leaves.
+		/// </summary>
+		static HashMap<std::string, Vector<ReactionAttributed*>> m_subtypeIndex;
+
+		/// <summary>
+		/// Reactions indexed while a message was being dispatched, added once it ends so the
+		/// message that created them doesn't reach them
+		/// </summary>
+		static Vector<ReactionAttributed*> m_pendingAdditions;
+
+		/// <summary>
+		/// The number of dispatches in progress
+		/// </summary>
+		static size_t m_dispatchDepth;
+
+		/// <summary>
+		/// Whether any reaction was tombstoned during the current dispatch
+		/// </summary>
+		static bool m_hasTombstones;
+
+		/// <summary>
+		/// Guards the index, since parallel Scope copies construct reactions on worker threads
+		/// </summary>
+		static std::mutex m_indexMutex;
+
+		/// <summary>
+		/// The dispatcher, subscribed once by SubscribeDispatcher and never unsubscribed
+		/// </summary>
+		static SubtypeDispatcher m_dispatcher;
 	};
 
 	ConcreteFactory(ReactionAttributed, Scope);
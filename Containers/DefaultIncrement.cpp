@@ -7,4 +7,9 @@ namespace FieaGameEngine
     {
         return capacity + 1;
     }
+
+    size_t DoublingIncrement::operator()(size_t /*size*/, size_t capacity) const
+    {
+        return (capacity == 0) ? 4 : capacity * 2;
+    }
 }
\ No newline at end of file
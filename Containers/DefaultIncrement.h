@@ -5,6 +5,11 @@ namespace FieaGameEngine
     {
         size_t operator()(size_t /*size*/, size_t capacity) const;
     };
+
+    struct DoublingIncrement final
+    {
+        size_t operator()(size_t /*size*/, size_t capacity) const;
+    };
 }
 
 
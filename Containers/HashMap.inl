@@ -193,12 +193,20 @@ namespace FieaGameEngine
         HashMap<TKey, TValue, HashFunctor, EqualityFunctor>::FindIt(const TKey& key)
     {
         HashFunctor hashFunc;
+        EqualityFunctor equalityFunc;
         size_t index = hashFunc(key) % m_buckets.Size();
 
-        PairType pair = std::make_pair(key, TValue());
-
         BucketIteratorType bucketIt = m_buckets.begin() + index;
-        ChainIteratorType chainIt = bucketIt->Find<KeyEquality>(pair);
+
+        // Compare keys directly rather than building a temporary pair, which would copy the key
+        ChainIteratorType chainIt = bucketIt->begin();
+        for (; chainIt != bucketIt->end(); ++chainIt)
+        {
+            if (equalityFunc((*chainIt).first, key))
+            {
+                break;
+            }
+        }
 
         return std::make_tuple(chainIt, bucketIt);
     }
@@ -0,0 +1,177 @@
+#pragma once
+#include "Vector.h"
+#include <cstddef>
+#include <mutex>
+
+namespace FieaGameEngine
+{
+    /// <summary>
+    /// Snapshot of how an ObjectPool's slots are currently used
+    /// </summary>
+    struct PoolStats final
+    {
+        /// <summary>
+        /// Slots currently holding a live object
+        /// </summary>
+        size_t m_live = 0;
+
+        /// <summary>
+        /// Slots currently on the free list
+        /// </summary>
+        size_t m_free = 0;
+
+        /// <summary>
+        /// The most slots that have ever been live at once
+        /// </summary>
+        size_t m_highWater = 0;
+
+        /// <summary>
+        /// The number of slabs the pool has allocated
+        /// </summary>
+        size_t m_slabCount = 0;
+    };
+
+    /// <summary>
+    /// ObjectPool is a templated slab allocator that hands out raw memory for objects of
+    /// exactly one type. Slots are carved out of large slabs and recycled through an
+    /// intrusive free list, so objects of the same type sit next to each other and
+    /// creating or destroying one never goes to the global heap. Types opt in with the
+    /// POOL_DECLARATIONS macro, which routes their operator new and delete through the
+    /// shared pool of that type.
+    /// </summary>
+    template <typename T>
+    class ObjectPool final
+    {
+    public:
+        /// <summary>
+        /// The number of slots in each slab the pool allocates on its own
+        /// </summary>
+        static const size_t DefaultSlabSize = 64;
+
+        /// <summary>
+        /// Constructor that sets how many slots each new slab holds. No memory is
+        /// allocated until the first object is.
+        /// </summary>
+        /// <param name="slabSize"> The number of slots per slab </param>
+        explicit ObjectPool(size_t slabSize = DefaultSlabSize);
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        /// <summary>
+        /// Destructor that frees every slab. Any object still living in the pool is
+        /// left dangling, so only destroy a pool once all of its objects are gone.
+        /// </summary>
+        ~ObjectPool();
+
+        /// <summary>
+        /// Gets memory for one object. Requests that aren't exactly sizeof(T), which
+        /// happens when a derived type inherits T's operator new, go to the global heap.
+        /// </summary>
+        /// <param name="size"> The number of bytes requested </param>
+        /// <returns> Uninitialized memory for the object </returns>
+        void* Allocate(size_t size);
+
+        /// <summary>
+        /// Returns memory previously handed out by Allocate
+        /// </summary>
+        /// <param name="memory"> The memory to return </param>
+        /// <param name="size"> The number of bytes that were requested for it </param>
+        void Deallocate(void* memory, size_t size);
+
+        /// <summary>
+        /// Makes sure at least count slots are free, allocating any shortfall as a single
+        /// slab. Slots already on the free list are still handed out first, so this bounds
+        /// how often a batch grows the pool rather than making the batch contiguous.
+        /// </summary>
+        /// <param name="count"> The number of free slots needed </param>
+        void Reserve(size_t count);
+
+        /// <summary>
+        /// Gets the current usage of the pool
+        /// </summary>
+        /// <returns> A snapshot of the pool's statistics </returns>
+        PoolStats Stats() const;
+
+        /// <summary>
+        /// Gets the pool shared by every object of type T. It is intentionally never
+        /// destroyed, since objects may still be deleted during static destruction.
+        /// </summary>
+        /// <returns> A reference to the shared pool </returns>
+        static ObjectPool& Shared();
+
+    private:
+        /// <summary>
+        /// One slot of a slab. While free it links to the next free slot, otherwise it
+        /// holds the object.
+        /// </summary>
+        union Slot
+        {
+            Slot* m_next;
+            alignas(T) std::byte m_storage[sizeof(T)];
+        };
+
+        /// <summary>
+        /// Allocates a new slab and threads its slots onto the free list in address
+        /// order, so consecutive allocations are adjacent
+        /// </summary>
+        /// <param name="slotCount"> The number of slots in the new slab </param>
+        void AddSlab(size_t slotCount);
+
+        /// <summary>
+        /// Every slab owned by this pool
+        /// </summary>
+        Vector<Slot*> m_slabs;
+
+        /// <summary>
+        /// The first free slot, nullptr if every slot is live
+        /// </summary>
+        Slot* m_freeList = nullptr;
+
+        /// <summary>
+        /// The number of slots in each slab the pool allocates on its own
+        /// </summary>
+        size_t m_slabSize;
+
+        /// <summary>
+        /// The number of live objects
+        /// </summary>
+        size_t m_live = 0;
+
+        /// <summary>
+        /// The number of free slots
+        /// </summary>
+        size_t m_free = 0;
+
+        /// <summary>
+        /// The most objects that have ever been live at once
+        /// </summary>
+        size_t m_highWater = 0;
+
+        /// <summary>
+        /// Guards the free list, since Scopes may be cloned on worker threads
+        /// </summary>
+        mutable std::mutex m_mutex;
+    };
+
+    /// <summary>
+    /// Declares a class specific operator new and delete that allocate the class out of
+    /// its shared ObjectPool. Put this in the body of any class that should be pooled.
+    /// </summary>
+    #define POOL_DECLARATIONS(Type)                                                                     \
+        public:                                                                                         \
+            using PooledType = Type;                                                                    \
+            static void* operator new(std::size_t size)                                                 \
+            {                                                                                           \
+                return FieaGameEngine::ObjectPool<Type>::Shared().Allocate(size);                       \
+            }                                                                                           \
+            static void operator delete(void* memory, std::size_t size)                                 \
+            {                                                                                           \
+                FieaGameEngine::ObjectPool<Type>::Shared().Deallocate(memory, size);                    \
+            }                                                                                           \
+        private:
+}
+
+#include "ObjectPool.inl"
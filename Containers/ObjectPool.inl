@@ -0,0 +1,119 @@
+#pragma once
+#include "ObjectPool.h"
+
+namespace FieaGameEngine
+{
+    template<typename T>
+    inline ObjectPool<T>::ObjectPool(size_t slabSize)
+        : m_slabSize(slabSize > 0 ? slabSize : DefaultSlabSize)
+    {
+    }
+
+    template<typename T>
+    inline ObjectPool<T>::~ObjectPool()
+    {
+        for (Slot* slab : m_slabs)
+        {
+            delete[] slab;
+        }
+    }
+
+    template<typename T>
+    inline void* ObjectPool<T>::Allocate(size_t size)
+    {
+        if (size != sizeof(T))
+        {
+            return ::operator new(size);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_freeList == nullptr)
+        {
+            AddSlab(m_slabSize);
+        }
+
+        Slot* slot = m_freeList;
+        m_freeList = slot->m_next;
+
+        --m_free;
+        ++m_live;
+        if (m_live > m_highWater)
+        {
+            m_highWater = m_live;
+        }
+
+        return slot->m_storage;
+    }
+
+    template<typename T>
+    inline void ObjectPool<T>::Deallocate(void* memory, size_t size)
+    {
+        if (memory == nullptr)
+        {
+            return;
+        }
+
+        if (size != sizeof(T))
+        {
+            ::operator delete(memory);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        Slot* slot = reinterpret_cast<Slot*>(memory);
+        slot->m_next = m_freeList;
+        m_freeList = slot;
+
+        ++m_free;
+        --m_live;
+    }
+
+    template<typename T>
+    inline void ObjectPool<T>::Reserve(size_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_free < count)
+        {
+            AddSlab(count - m_free);
+        }
+    }
+
+    template<typename T>
+    inline PoolStats ObjectPool<T>::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        PoolStats stats;
+        stats.m_live = m_live;
+        stats.m_free = m_free;
+        stats.m_highWater = m_highWater;
+        stats.m_slabCount = m_slabs.Size();
+        return stats;
+    }
+
+    template<typename T>
+    inline ObjectPool<T>& ObjectPool<T>::Shared()
+    {
+        static ObjectPool* const sharedPool = new ObjectPool();
+        return *sharedPool;
+    }
+
+    template<typename T>
+    inline void ObjectPool<T>::AddSlab(size_t slotCount)
+    {
+        Slot* slab = new Slot[slotCount];
+        m_slabs.PushBack(slab);
+
+        // Push in reverse so the free list hands the slots out in address order
+        for (size_t i = slotCount; i > 0; --i)
+        {
+            slab[i - 1].m_next = m_freeList;
+            m_freeList = &slab[i - 1];
+        }
+
+        m_free += slotCount;
+    }
+}
@@ -8,35 +8,49 @@ namespace FieaGameEngine
     RTTI_DEFINITIONS(Attributed);
 
     Attributed::Attributed(const Attributed& other)
-        : Scope(other)
+        : Scope(other, Binding{ &other, other.m_prescribedCount }), m_prescribedCount(other.m_prescribedCount), m_layout(other.m_layout)
     {
-        UpdateExternalStorage(other);
+        m_order[0].second = this;
     }
 
     Attributed::Attributed(Attributed&& other) noexcept
-        : Scope(std::move(other))
+        : Scope(std::move(other), Binding{ &other, other.m_prescribedCount }), m_prescribedCount(other.m_prescribedCount), m_layout(other.m_layout)
     {
-        UpdateExternalStorage(other);
+        m_order[0].second = this;
     }
 
     Attributed& Attributed::operator=(const Attributed& other)
     {
-        Scope::operator=(other);
-        UpdateExternalStorage(other);
+        if (this != &other)
+        {
+            Scope::Assign(other, Binding{ &other, other.m_prescribedCount });
+            m_prescribedCount = other.m_prescribedCount;
+            m_layout = other.m_layout;
+            m_order[0].second = this;
+        }
+
         return *this;
     }
 
     Attributed& Attributed::operator=(Attributed&& other) noexcept
     {
-        Scope::operator=(std::move(other));
-        UpdateExternalStorage(other);
+        Scope::Assign(std::move(other), Binding{ &other, other.m_prescribedCount });
+        m_prescribedCount = other.m_prescribedCount;
+        m_layout = other.m_layout;
+        m_order[0].second = this;
         return *this;
     }
 
     Attributed::Attributed(RTTI::IdType type)
+        : Attributed(TypeManager::GetLayout(type))
+    {
+    }
+
+    Attributed::Attributed(const TypeLayout& layout)
+        : Scope(layout.m_prototype, Binding{ nullptr, layout.m_prescribedCount }), m_prescribedCount(layout.m_prescribedCount), m_layout(&layout)
     {
-        (*this)["this"] = this;
-        PopulateScope(type);
+        // The prototype's external storage Datums hold offsets, which the copy rebased onto us
+        m_order[0].second = this;
     }
 
     bool Attributed::IsAttribute(const std::string& key) const
@@ -51,16 +65,8 @@ namespace FieaGameEngine
             return true;
         }
 
-        Vector<Signature> signatures = TypeManager::GetSignatures(TypeIdInstance());
-        for (Signature& signature : signatures)
-        {
-            if (key == signature.m_name)
-            {
-                return true;
-            }
-        }
-
-        return false;
+        // The prototype holds exactly the prescribed attributes, already indexed by name
+        return (m_layout != nullptr && m_layout->m_prototype.Find(key) != nullptr);
     }
 
     bool Attributed::IsAuxiliaryAttribute(const std::string& key) const
@@ -78,75 +84,55 @@ namespace FieaGameEngine
         return Append(key);
     }
 
-    const Vector<Scope::PairType*>& Attributed::GetAttributes() const
+    const Scope::OrderType& Attributed::GetAttributes() const
     {
         return m_order;
     }
 
-    Vector<Scope::PairType*> Attributed::GetPrescribedAttributes() const
+    gsl::span<const Scope::PairType> Attributed::GetPrescribedAttributes() const
     {
-        Vector<Scope::PairType*> prescribedAttributes;
-        for (PairType* ptr : m_order)
+        if (m_order.IsEmpty())
         {
-            if (IsPrescribedAttribute(ptr->first))
-            {
-                prescribedAttributes.PushBack(ptr);
-            }
+            return gsl::span<const Scope::PairType>();
         }
 
-        return prescribedAttributes;
+        size_t prescribedCount = std::min(m_prescribedCount, Size());
+        return gsl::span<const Scope::PairType>(&m_order[0], prescribedCount);
     }
 
-    Vector<Scope::PairType*> Attributed::GetAuxiliaryAttributes() const
+    gsl::span<const Scope::PairType> Attributed::GetAuxiliaryAttributes() const
     {
-        Vector<Scope::PairType*> auxiliaryAttributes;
-        for (PairType* ptr : m_order)
+        if (m_order.IsEmpty())
         {
-            if (!IsPrescribedAttribute(ptr->first))
-            {
-                auxiliaryAttributes.PushBack(ptr);
-            }
+            return gsl::span<const Scope::PairType>();
         }
 
-        return auxiliaryAttributes;
+        size_t prescribedCount = std::min(m_prescribedCount, Size());
+        return gsl::span<const Scope::PairType>(&m_order[0] + prescribedCount, Size() - prescribedCount);
     }
 
-    void Attributed::PopulateScope(RTTI::IdType type)
+    void Attributed::BuildPrototype(const Vector<StaticSignature>& signatures, Scope& prototype)
     {
-        // Go through all the signatures for this type and add them to our scope structure
-        Vector<Signature> signatures = TypeManager::GetSignatures(type);
-        for (Signature& signature : signatures)
+        prototype = Scope(signatures.Size() + 1);
+        prototype["this"] = static_cast<RTTI*>(nullptr);
+
+        for (const StaticSignature& signature : signatures)
         {
-            Datum& appendedDatum = Append(signature.m_name);
+            const std::string name(signature.m_name);
 
+            // Appending moves the pairs, so never hold on to the appended Datum across another append
             if (signature.m_type == Datum::DatumType::Table)
             {
-                appendedDatum.SetType(signature.m_type);
+                prototype.Append(name).SetType(signature.m_type);
                 for (size_t i = 0; i < signature.m_size; ++i)
                 {
-                    AppendScope(signature.m_name);
+                    prototype.AppendScope(name);
                 } 
             }
             else
             {
-                void* data = reinterpret_cast<std::uint8_t*>(this) + signature.m_storageOffset;
-                appendedDatum.SetStorage(data, signature.m_size);
-            }
-        }
-    }
-
-    void Attributed::UpdateExternalStorage(const Attributed& other)
-    {
-        (*this)["this"] = this;
-
-        Vector<Signature> signatures = TypeManager::GetSignatures(other.TypeIdInstance());
-        for (Signature& signature : signatures)
-        {
-            if (signature.m_type != Datum::DatumType::Table)
-            {
-                Datum* foundDatum = Find(signature.m_name);
-                void* data = reinterpret_cast<std::uint8_t*>(this) + signature.m_storageOffset;
-                foundDatum->m_data.vp = data;
+                // There is no instance yet, so remember the offset and let each instance relocate it
+                prototype.Append(name).SetStorage(reinterpret_cast<void*>(signature.m_storageOffset), signature.m_size);
             }
         }
     }
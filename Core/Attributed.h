@@ -3,6 +3,10 @@
 
 namespace FieaGameEngine
 {
+    struct StaticSignature;
+    struct TypeLayout;
+    class TypeManager;
+
     /// <summary>
     /// Attributed class that serves as a way of converting C++ classes that contain
     /// signatures for their member variables into a Scope with key, Datum pairs.
@@ -10,6 +14,7 @@ namespace FieaGameEngine
 	class Attributed : public Scope 
 	{
 		RTTI_DECLARATIONS(Attributed, Scope);
+        friend TypeManager;
 
     public:
         /// <summary>
@@ -19,33 +24,33 @@ namespace FieaGameEngine
 
         /// <summary>
         /// Copy constructor. The underlying Scope is copied from the passed in
-        /// Attributed and then the external storage pointers are adjusted to 
-        /// point to the new object instance.
+        /// Attributed. The external storage pointers are adjusted to point to
+        /// the new object instance before the constructor returns.
         /// </summary>
         /// <param name="other"> The other Attributed to copy from </param>
         Attributed(const Attributed& other);
 
         /// <summary>
         /// Move constructor. The underlying Scope's memory is stolen from 
-        /// the passed in Attributed and then the external storage pointers are 
-        /// adjusted to point to the new object instance.
+        /// the passed in Attributed. The external storage pointers are adjusted
+        /// to point to the new object instance before the constructor returns.
         /// </summary>
         /// <param name="other"> The other Attributed to move from </param>
         Attributed(Attributed&& other) noexcept;
 
         /// <summary>
         /// Copy assignment. This Attributed is cleared and then the underlying 
-        /// Scope is copied from the passed in Attributed and then the external 
-        /// storage pointers are adjusted to point to the new object instance.
+        /// Scope is copied from the passed in Attributed. The external storage
+        /// pointers are adjusted before returning, as with copy construction.
         /// </summary>
         /// <param name="other"> The other Attributed to copy from </param>
         Attributed& operator=(const Attributed& other);
 
         /// <summary>
         /// Move constructor. This attributed is cleared and then the underlying 
-        /// Scope's memory is stolen from the passed in Attributed and then the 
-        /// external storage pointers are adjusted to point to the new object 
-        /// instance.
+        /// Scope's memory is stolen from the passed in Attributed. The external
+        /// storage pointers are adjusted before returning, as with move
+        /// construction.
         /// </summary>
         /// <param name="other"> The other Attributed to move from </param>
         Attributed& operator=(Attributed&& other) noexcept;
@@ -87,7 +92,8 @@ namespace FieaGameEngine
         /// appending an auxiliary attribute that is already prescribed.
         /// </summary>
         /// <param name="key"> The key to append </param>
-        /// <returns> The datum of the appended attribute </returns>
+        /// <returns> The datum of the appended attribute, which is invalidated by
+        /// appending any other new key </returns>
         /// <exception cref="std::runtime_error"> Throws if the passed in key
         /// is already the key of a prescribed attribute </exception>
         Datum& AppendAuxiliaryAttribute(const std::string& key);
@@ -96,50 +102,75 @@ namespace FieaGameEngine
         /// Gets all of the attributes currently associated with this object, which
         /// includes both prescribed and auxiliary attributes
         /// </summary>
-        /// <returns> A vector of pointers to pairs, where each pair represents
+        /// <returns> The contiguous, insert ordered vector of pairs, where each pair represents
         /// one attribute </returns>
-        const Vector<Scope::PairType*>& GetAttributes() const;
+        const Scope::OrderType& GetAttributes() const;
 
         /// <summary>
         /// Gets all of the prescribed attributes associated with this class, including 
-        /// the "this" pointer
+        /// the "this" pointer. Prescribed attributes are always the first entries in insert
+        /// order, so this is a view over the attribute storage and doesn't allocate.
         /// </summary>
-        /// <returns> A vector of pointer to pairs, where each pair represents
-        /// one attribute </returns>
-        Vector<Scope::PairType*> GetPrescribedAttributes() const;
+        /// <returns> A view of the pairs representing the prescribed attributes. It is
+        /// invalidated by appending an auxiliary attribute. </returns>
+        gsl::span<const Scope::PairType> GetPrescribedAttributes() const;
 
         /// <summary>
-        /// Gets all of the auxiliary attributes associated with this object
+        /// Gets all of the auxiliary attributes associated with this object. Auxiliary 
+        /// attributes always follow the prescribed ones, so this is a view over the attribute
+        /// storage and doesn't allocate.
         /// </summary>
-        /// <returns> A vector of pointer to pairs, where each pair represents
-        /// one attribute </returns>
-        Vector<Scope::PairType*> GetAuxiliaryAttributes() const;
+        /// <returns> A view of the pairs representing the auxiliary attributes. It is
+        /// invalidated by appending an auxiliary attribute. </returns>
+        gsl::span<const Scope::PairType> GetAuxiliaryAttributes() const;
+
+        /// <summary>
+        /// Gets the number of prescribed attributes this object has, including "this". This is
+        /// also the index of the first auxiliary attribute.
+        /// </summary>
+        /// <returns> The number of prescribed attributes </returns>
+        inline size_t PrescribedAttributeCount() const { return m_prescribedCount; }
 
     protected:
         /// <summary>
         /// Explicit constructor for Attributed that takes in the underlying
         /// type of the object. This is intended to only ever be called from the
-        /// constructors of child classes.
+        /// constructors of child classes. The attribute table is copied from the
+        /// type's prebuilt prototype, so no keys are hashed or appended here.
         /// </summary>
         /// <param name="type"> The underlying type of the child class </param>
         explicit Attributed(RTTI::IdType type);
 
     private:
+        /// <summary>
+        /// Constructor that copies the attribute table from a type's prototype. The prototype's
+        /// external storage Datums hold the signature's offset, which the copy rebases onto
+        /// this instance as it copies each pair.
+        /// </summary>
+        /// <param name="layout"> The layout of the underlying type </param>
+        explicit Attributed(const TypeLayout& layout);
+
+        /// <summary>
+        /// Builds the prototype attribute table for a type: "this" followed by a Datum for
+        /// every signature, with external storage Datums holding their offset instead of a
+        /// pointer. Called by the TypeManager whenever it rebuilds the layouts.
+        /// </summary>
+        /// <param name="signatures"> The flattened signatures of the type </param>
+        /// <param name="prototype"> The Scope to build the table into </param>
+        static void BuildPrototype(const Vector<StaticSignature>& signatures, Scope& prototype);
 
         /// <summary>
-        /// Helper method that populates this Scope with all of the prescribed
-        /// attributes based on the passed in IdType
+        /// The number of prescribed attributes (including "this") at the front of the
+        /// attribute storage. Everything after this boundary is auxiliary.
         /// </summary>
-        /// <param name="type"> The IdType to use for retrieving prescribed
-        /// attributes </param>
-        void PopulateScope(RTTI::IdType type);
+        size_t m_prescribedCount = 0;
 
         /// <summary>
-        /// Helper method that updates external storage pointers to point to the
-        /// this new instance of the object
+        /// The layout of this object's type, used to bind external storage Datums and to tell
+        /// prescribed attributes apart without going back through the TypeManager. Layouts stay
+        /// valid for as long as the type is registered.
         /// </summary>
-        /// <param name="other"> The old object that the pointers pointed to </param>
-        void UpdateExternalStorage(const Attributed& other);
+        const TypeLayout* m_layout = nullptr;
 	};
 }
 
@@ -30,6 +30,7 @@ namespace FieaGameEngine
         if (other.m_externalStorage)
         {
             m_externalStorage = true;
+            m_writeHook = other.m_writeHook;
             m_data.vp = other.m_data.vp;
             m_size = other.m_size;
             m_capacity = other.m_capacity;
@@ -72,6 +73,7 @@ namespace FieaGameEngine
                 }
 
                 m_externalStorage = true;
+                m_writeHook = other.m_writeHook;
                 m_type = other.m_type;
                 m_data.vp = other.m_data.vp;
                 m_size = other.m_size;
@@ -103,6 +105,7 @@ namespace FieaGameEngine
                 }
 
                 m_externalStorage = false;
+                m_writeHook = 0;
                 m_type = other.m_type;
                 Reserve(other.m_capacity);
 
@@ -133,11 +136,13 @@ namespace FieaGameEngine
 	{
 		m_data.vp = other.m_data.vp;
         m_externalStorage = other.m_externalStorage;
+        m_writeHook = other.m_writeHook;
 
 		other.m_type = DatumType::Unknown;
 		other.m_size = 0;
 		other.m_capacity = 0;
 		other.m_data.vp = nullptr;
+        other.m_writeHook = 0;
 	}
 
 	Datum& Datum::operator=(Datum&& other) noexcept
@@ -156,11 +161,13 @@ namespace FieaGameEngine
 			m_capacity = other.m_capacity;
 			m_data.vp = other.m_data.vp;
             m_externalStorage = other.m_externalStorage;
+            m_writeHook = other.m_writeHook;
 
             other.m_type = DatumType::Unknown;
             other.m_size = 0;
             other.m_capacity = 0;
             other.m_data.vp = nullptr;
+            other.m_writeHook = 0;
 		}
 
 		return *this;
@@ -478,6 +485,7 @@ namespace FieaGameEngine
 		}
 
 		m_data.i[index] = value;
+		NotifyWrite(index);
 	}
 
 	void Datum::Set(std::string value, size_t index)
@@ -493,6 +501,7 @@ namespace FieaGameEngine
         }
 
 		m_data.s[index] = value;
+		NotifyWrite(index);
 	}
 
 	void Datum::Set(float value, size_t index)
@@ -508,6 +517,7 @@ namespace FieaGameEngine
         }
 
         m_data.f[index] = value;
+        NotifyWrite(index);
 	}
 
 	void Datum::Set(glm::vec4 value, size_t index)
@@ -523,6 +533,7 @@ namespace FieaGameEngine
         }
 
 		m_data.v[index] = value;
+		NotifyWrite(index);
 	}
 
 	void Datum::Set(glm::mat4 value, size_t index)
@@ -538,6 +549,7 @@ namespace FieaGameEngine
         }
 
 		m_data.m[index] = value;
+		NotifyWrite(index);
 	}
 
 	void Datum::Set(RTTI* value, size_t index)
@@ -553,6 +565,7 @@ namespace FieaGameEngine
         }
 
 		m_data.r[index] = value;
+		NotifyWrite(index);
 	}
 
     void Datum::Set(Scope* value, size_t index)
@@ -576,6 +589,33 @@ namespace FieaGameEngine
     }
 #pragma endregion
 
+#pragma region WriteHooks
+    std::uint8_t Datum::RegisterWriteHook(WriteHook hook)
+    {
+        if (m_writeHookCount == m_maxWriteHooks)
+        {
+            throw std::runtime_error("Too many Datum write hooks registered!");
+        }
+
+        m_writeHooks[m_writeHookCount] = hook;
+        return m_writeHookCount++;
+    }
+
+    void Datum::SetWriteHook(std::uint8_t hook)
+    {
+        assert(hook < m_writeHookCount);
+        m_writeHook = hook;
+    }
+
+    void Datum::NotifyWrite(size_t index)
+    {
+        if (m_writeHook != 0)
+        {
+            m_writeHooks[m_writeHook](m_data.vp, index);
+        }
+    }
+#pragma endregion
+
 #pragma region PushBack
 	void Datum::PushBack(int value)
 	{
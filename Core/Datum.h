@@ -441,6 +441,34 @@ namespace FieaGameEngine
         void Set(Scope* value, size_t index = 0);
 		#pragma endregion
 
+		#pragma region WriteHooks
+        /// <summary>
+        /// Function called after a value is Set into a Datum that has a hook. It gets the
+        /// Datum's storage and the index written, which is enough for the owner of external
+        /// storage to find itself.
+        /// </summary>
+        using WriteHook = void(*)(void* storage, size_t index);
+
+        /// <summary>
+        /// Registers a write hook so Datums can refer to it by id. Only meant to be called
+        /// during static initialization, since the table isn't guarded.
+        /// </summary>
+        /// <param name="hook"> The hook to register </param>
+        /// <returns> The id to pass to SetWriteHook </returns>
+        /// <exception cref="std::runtime_error"> Throws if the table of hooks is full </exception>
+        static std::uint8_t RegisterWriteHook(WriteHook hook);
+
+        /// <summary>
+        /// Makes this Datum call a registered hook after every Set. Only writes made through
+        /// Set and the assignment and SetFromString functions that use it are seen; writes
+        /// through the reference Get returns are not. Copies of a Datum with external storage
+        /// keep the hook, since they write the same storage, but copies into internal storage
+        /// don't.
+        /// </summary>
+        /// <param name="hook"> An id returned by RegisterWriteHook, or 0 for none </param>
+        void SetWriteHook(std::uint8_t hook);
+		#pragma endregion
+
 		#pragma region PushBack
 		/// <summary>
 		/// Pushes the given value into the back of the Datum
@@ -1033,6 +1061,27 @@ namespace FieaGameEngine
 
         void PushBack(Scope& value);
 
+		/// <summary>
+		/// Calls this Datum's write hook, if it has one
+		/// </summary>
+		/// <param name="index"> The index that was written </param>
+		void NotifyWrite(size_t index);
+
+		/// <summary>
+		/// How many write hooks can be registered, including the reserved 0
+		/// </summary>
+		static const std::uint8_t m_maxWriteHooks = 8;
+
+		/// <summary>
+		/// The registered write hooks, indexed by id. Id 0 is reserved for no hook.
+		/// </summary>
+		inline static WriteHook m_writeHooks[m_maxWriteHooks]{};
+
+		/// <summary>
+		/// How many ids have been handed out, including the reserved 0
+		/// </summary>
+		inline static std::uint8_t m_writeHookCount = 1;
+
 		/// <summary>
 		/// Gets the size of the current type in bytes
 		/// </summary>
@@ -1058,6 +1107,12 @@ namespace FieaGameEngine
 		/// </summary>
 		bool m_externalStorage = false;
 
+		/// <summary>
+		/// The id of the hook to call after a Set, 0 for none. Sits in what would otherwise
+		/// be padding.
+		/// </summary>
+		std::uint8_t m_writeHook = 0;
+
 		/// <summary>
 		/// How many elements are in this Datum
 		/// </summary>
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "DatumHandle.h"
+#include "Scope.h"
+
+namespace FieaGameEngine
+{
+    DatumHandle::DatumHandle(const DatumHandle&)
+    {
+    }
+
+    DatumHandle& DatumHandle::operator=(const DatumHandle& other)
+    {
+        if (this != &other)
+        {
+            Reset();
+        }
+
+        return *this;
+    }
+
+    Datum* DatumHandle::Resolve(Scope& scope, const std::string& key)
+    {
+        if (IsBound() && m_chain[0].m_scope == &scope && m_key == key)
+        {
+            return m_datum;
+        }
+
+        Reset();
+
+        // Same walk as Scope::Search, remembering every scope passed through
+        for (Scope* current = &scope; current != nullptr; current = current->GetParent())
+        {
+            m_chain.PushBack(ChainLink{ current, current->StructureVersion() });
+
+            Datum* foundDatum = current->Find(key);
+            if (foundDatum != nullptr)
+            {
+                m_datum = foundDatum;
+                m_key = key;
+                return m_datum;
+            }
+        }
+
+        m_chain.Clear();
+        return nullptr;
+    }
+
+    void DatumHandle::Reset()
+    {
+        m_datum = nullptr;
+        m_key.clear();
+        m_chain.Clear();
+    }
+
+    bool DatumHandle::IsBound() const
+    {
+        if (m_datum == nullptr)
+        {
+            return false;
+        }
+
+        for (const ChainLink& link : m_chain)
+        {
+            if (link.m_scope->StructureVersion() != link.m_structureVersion)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Datum.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+    class Scope;
+
+    /// <summary>
+    /// Caches the result of searching a Scope chain for a key. The handle remembers the
+    /// structure version of every Scope the search passed through, from the starting scope up
+    /// to the one holding the Datum, and only searches again once one of those changes or a
+    /// different scope or key is asked for. Changes anywhere else in the tree leave it bound.
+    /// Copies start unbound, since a copied action lives in a different tree.
+    /// </summary>
+    class DatumHandle final
+    {
+    public:
+        DatumHandle() = default;
+
+        /// <summary>
+        /// Copy constructor. The copy is unbound.
+        /// </summary>
+        DatumHandle(const DatumHandle&);
+
+        /// <summary>
+        /// Copy assignment. This handle becomes unbound.
+        /// </summary>
+        /// <returns> A reference to this handle </returns>
+        DatumHandle& operator=(const DatumHandle&);
+
+        ~DatumHandle() = default;
+
+        /// <summary>
+        /// Gets the Datum the key resolves to from the given scope, searching up the scope chain
+        /// only if the cached result is stale
+        /// </summary>
+        /// <param name="scope"> The scope to search from </param>
+        /// <param name="key"> The key to search for </param>
+        /// <returns> The found Datum, or nullptr if the key isn't in the scope chain </returns>
+        Datum* Resolve(Scope& scope, const std::string& key);
+
+        /// <summary>
+        /// Forgets the cached Datum so the next Resolve searches again
+        /// </summary>
+        void Reset();
+
+        /// <summary>
+        /// Checks if the handle holds a Datum that is still valid
+        /// </summary>
+        /// <returns> True if the cached Datum can be used, false otherwise </returns>
+        bool IsBound() const;
+
+    private:
+        /// <summary>
+        /// One Scope the search passed through, and its structure version at the time
+        /// </summary>
+        struct ChainLink
+        {
+            const Scope* m_scope;
+            std::uint32_t m_structureVersion;
+        };
+
+        /// <summary>
+        /// The cached Datum, nullptr when unbound
+        /// </summary>
+        Datum* m_datum = nullptr;
+
+        /// <summary>
+        /// The key the cached Datum was searched for
+        /// </summary>
+        std::string m_key;
+
+        /// <summary>
+        /// The Scopes searched, starting scope first. Checked in that order, so a parent is only
+        /// read once its child's unchanged version proves it is still the parent.
+        /// </summary>
+        Vector<ChainLink> m_chain;
+    };
+}
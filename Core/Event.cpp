@@ -1,17 +1,159 @@
 #include "pch.h"
 #include "Event.h"
+#include "EventTrace.h"
 
 namespace FieaGameEngine
 {
     RTTI_DEFINITIONS(EventPublisher);
 
+    SubscriptionHandle SubscriberList::Subscribe(EventSubscriber& subscriber)
+    {
+        auto it = m_slotIndex.Find(&subscriber);
+        if (it != m_slotIndex.end())
+        {
+            return SubscriptionHandle{ it->second, m_slots[it->second].m_generation };
+        }
+
+        // A freed slot could lie ahead of a delivery in progress, so only recycle when none is
+        size_t slot;
+        if (m_deliveryDepth == 0 && !m_freeSlots.IsEmpty())
+        {
+            slot = m_freeSlots.Back();
+            m_freeSlots.PopBack();
+        }
+        else
+        {
+            slot = m_slots.Size();
+            m_slots.PushBack(Slot{ nullptr, 0 });
+        }
+
+        m_slots[slot] = Slot{ &subscriber, m_nextGeneration++ };
+        m_slotIndex.Insert(std::make_pair(&subscriber, slot));
+        ++m_size;
+
+        return SubscriptionHandle{ slot, m_slots[slot].m_generation };
+    }
+
+    bool SubscriberList::Unsubscribe(EventSubscriber& subscriber)
+    {
+        auto it = m_slotIndex.Find(&subscriber);
+        if (it == m_slotIndex.end())
+        {
+            return false;
+        }
+
+        ReleaseSlot(it->second);
+        return true;
+    }
+
+    bool SubscriberList::Unsubscribe(SubscriptionHandle handle)
+    {
+        if (handle.m_slot >= m_slots.Size())
+        {
+            return false;
+        }
+
+        const Slot& slot = m_slots[handle.m_slot];
+        if (slot.m_subscriber == nullptr || slot.m_generation != handle.m_generation)
+        {
+            return false;
+        }
+
+        ReleaseSlot(handle.m_slot);
+        return true;
+    }
+
+    void SubscriberList::Clear()
+    {
+        if (m_deliveryDepth > 0)
+        {
+            for (size_t slot = 0; slot < m_slots.Size(); ++slot)
+            {
+                if (m_slots[slot].m_subscriber != nullptr)
+                {
+                    ReleaseSlot(slot);
+                }
+            }
+
+            return;
+        }
+
+        m_slots.Clear();
+        m_slots.ShrinkToFit();
+        m_freeSlots.Clear();
+        m_freeSlots.ShrinkToFit();
+        m_pendingFreeSlots.Clear();
+        m_pendingFreeSlots.ShrinkToFit();
+        m_slotIndex.Clear();
+        m_size = 0;
+    }
+
+    void SubscriberList::EndDelivery()
+    {
+        if (--m_deliveryDepth == 0)
+        {
+            for (size_t slot : m_pendingFreeSlots)
+            {
+                m_freeSlots.PushBack(slot);
+            }
+            m_pendingFreeSlots.Clear();
+        }
+    }
+
+    void SubscriberList::ReleaseSlot(size_t slot)
+    {
+        m_slotIndex.Remove(m_slots[slot].m_subscriber);
+        m_slots[slot].m_subscriber = nullptr;
+        --m_size;
+
+        if (m_deliveryDepth > 0)
+        {
+            m_pendingFreeSlots.PushBack(slot);
+        }
+        else
+        {
+            m_freeSlots.PushBack(slot);
+        }
+    }
+
     void EventPublisher::Deliver() const
     {
-        // for each subscriber in the m_subscribers list, call notify
-        for (EventSubscriber* subscriber : *m_subscribersPtr)
+        SubscriberList& subscribers = *m_subscribersPtr;
+        SubscriberList::DeliveryGuard guard(subscribers);
+
+        // Anyone subscribing from a Notify lands past this count and waits for the next event
+        size_t slotCount = subscribers.SlotCount();
+
+        if (!EventTrace::IsEnabled())
         {
-            subscriber->Notify(*this);
+            for (size_t slot = 0; slot < slotCount; ++slot)
+            {
+                EventSubscriber* subscriber = subscribers.SlotAt(slot);
+                if (subscriber != nullptr)
+                {
+                    subscriber->Notify(*this);
+                }
+            }
+
+            return;
+        }
+
+        size_t notifiedCount = 0;
+        auto deliverStart = EventTrace::Clock::now();
+
+        for (size_t slot = 0; slot < slotCount; ++slot)
+        {
+            EventSubscriber* subscriber = subscribers.SlotAt(slot);
+            if (subscriber != nullptr)
+            {
+                auto notifyStart = EventTrace::Clock::now();
+                subscriber->Notify(*this);
+                EventTrace::RecordNotify(*this, notifyStart, EventTrace::Clock::now());
+                ++notifiedCount;
+            }
         }
+
+        EventTrace::RecordDeliver(*this, notifiedCount, deliverStart, EventTrace::Clock::now());
     }
 
 }
\ No newline at end of file
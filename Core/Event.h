@@ -2,9 +2,17 @@
 #include "RTTI.h"
 #include "Vector.h"
 #include "SList.h"
+#include "HashMap.h"
 #include <chrono>
 #include "GameTime.h"
+#include "ObjectPool.h"
+#include <cstdint>
+#include <climits>
+#include <functional>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 
 namespace FieaGameEngine
 {
@@ -18,6 +26,17 @@ namespace FieaGameEngine
 
 
     public:
+        /// <summary>
+        /// Affinity group of subscribers that must be notified on the thread that owns the
+        /// EventQueue. This is the default, since most subscribers touch the world.
+        /// </summary>
+        static const std::uint32_t MainThreadGroup = 0;
+
+        /// <summary>
+        /// Affinity group of subscribers that are fully thread-safe, and may be notified on
+        /// any thread at the same time as anything else, including themselves
+        /// </summary>
+        static const std::uint32_t ThreadSafeGroup = UINT32_MAX;
 
         /// <summary>
         /// Default destructor
@@ -30,6 +49,225 @@ namespace FieaGameEngine
         /// </summary>
         /// <param name=""> The event being receieved </param>
         virtual void Notify(const class EventPublisher&) = 0;
+
+        /// <summary>
+        /// Gets the affinity group this subscriber is notified in when an EventQueue delivers in
+        /// parallel. Subscribers that share a group are notified one at a time, in delivery order,
+        /// on one worker thread; different groups run at the same time. Override this to return
+        /// ThreadSafeGroup or a group of your own to opt out of the main thread.
+        /// </summary>
+        /// <returns> The affinity group of this subscriber </returns>
+        virtual std::uint32_t AffinityGroup() const { return MainThreadGroup; }
+    };
+
+    /// <summary>
+    /// Handle to one subscription in a SubscriberList. A handle goes stale once its
+    /// subscription ends, so it can never unsubscribe whoever reuses the slot.
+    /// </summary>
+    struct SubscriptionHandle final
+    {
+        /// <summary>
+        /// The slot of the subscription
+        /// </summary>
+        size_t m_slot = SIZE_MAX;
+
+        /// <summary>
+        /// The generation the slot had when the subscription was made
+        /// </summary>
+        std::uint32_t m_generation = 0;
+    };
+
+    /// <summary>
+    /// Registry of the subscribers to one event type. Subscribers live in slots that
+    /// are tombstoned on unsubscribe and recycled through a free list, so subscribing
+    /// and unsubscribing are constant time and never move other subscribers. While an
+    /// event is being delivered, tombstoned slots aren't recycled and new subscribers
+    /// go past the end of the slots being walked, so a delivery never notifies a
+    /// subscriber that has left or one that joined after it started.
+    /// </summary>
+    class SubscriberList final
+    {
+    public:
+        /// <summary>
+        /// Marks a SubscriberList as being delivered to for the lifetime of the guard.
+        /// Recycling of the slots freed meanwhile is deferred until the last guard ends.
+        /// </summary>
+        class DeliveryGuard final
+        {
+        public:
+            explicit DeliveryGuard(SubscriberList& subscribers)
+                : m_subscribers(subscribers)
+            {
+                m_subscribers.BeginDelivery();
+            }
+
+            DeliveryGuard(const DeliveryGuard&) = delete;
+            DeliveryGuard& operator=(const DeliveryGuard&) = delete;
+
+            ~DeliveryGuard()
+            {
+                m_subscribers.EndDelivery();
+            }
+
+        private:
+            SubscriberList& m_subscribers;
+        };
+
+        /// <summary>
+        /// Adds a subscriber. If it is already subscribed, nothing changes.
+        /// </summary>
+        /// <param name="subscriber"> The subscriber to add </param>
+        /// <returns> A handle to the subscription </returns>
+        SubscriptionHandle Subscribe(EventSubscriber& subscriber);
+
+        /// <summary>
+        /// Removes a subscriber. Safe to call while an event is being delivered.
+        /// </summary>
+        /// <param name="subscriber"> The subscriber to remove </param>
+        /// <returns> True if the subscriber was removed, false if it wasn't subscribed </returns>
+        bool Unsubscribe(EventSubscriber& subscriber);
+
+        /// <summary>
+        /// Removes the subscription a handle refers to, without looking the subscriber up.
+        /// Safe to call while an event is being delivered.
+        /// </summary>
+        /// <param name="handle"> The handle returned by Subscribe </param>
+        /// <returns> True if the subscription was removed, false if the handle is stale </returns>
+        bool Unsubscribe(SubscriptionHandle handle);
+
+        /// <summary>
+        /// Removes every subscriber, releasing the list's memory unless an event is being
+        /// delivered
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        /// Gets the number of subscribers
+        /// </summary>
+        /// <returns> The number of subscribers </returns>
+        size_t Size() const { return m_size; }
+
+        /// <summary>
+        /// Gets the number of slots to walk when delivering, including tombstones
+        /// </summary>
+        /// <returns> The number of slots </returns>
+        size_t SlotCount() const { return m_slots.Size(); }
+
+        /// <summary>
+        /// Gets the subscriber in a slot
+        /// </summary>
+        /// <param name="slot"> The slot to read </param>
+        /// <returns> The subscriber, or nullptr if the slot is a tombstone </returns>
+        EventSubscriber* SlotAt(size_t slot) const { return m_slots[slot].m_subscriber; }
+
+    private:
+        /// <summary>
+        /// One subscriber slot
+        /// </summary>
+        struct Slot
+        {
+            EventSubscriber* m_subscriber;
+            std::uint32_t m_generation;
+        };
+
+        friend class EventQueue;
+
+        /// <summary>
+        /// Marks the start of a delivery
+        /// </summary>
+        void BeginDelivery() { ++m_deliveryDepth; }
+
+        /// <summary>
+        /// Marks the end of a delivery, recycling the slots freed during it if it was the last
+        /// </summary>
+        void EndDelivery();
+
+        /// <summary>
+        /// Tombstones a live slot and queues it for recycling
+        /// </summary>
+        /// <param name="slot"> The slot to release </param>
+        void ReleaseSlot(size_t slot);
+
+        /// <summary>
+        /// Every slot, live or tombstoned
+        /// </summary>
+        Vector<Slot> m_slots;
+
+        /// <summary>
+        /// Tombstoned slots that may be reused
+        /// </summary>
+        Vector<size_t> m_freeSlots;
+
+        /// <summary>
+        /// Slots tombstoned during a delivery, which become free once it ends
+        /// </summary>
+        Vector<size_t> m_pendingFreeSlots;
+
+        /// <summary>
+        /// The slot of every live subscriber
+        /// </summary>
+        HashMap<EventSubscriber*, size_t> m_slotIndex;
+
+        /// <summary>
+        /// Handed to each new subscription. Never reset, so stale handles stay stale even
+        /// after the list is cleared.
+        /// </summary>
+        std::uint32_t m_nextGeneration = 1;
+
+        /// <summary>
+        /// The number of deliveries in progress
+        /// </summary>
+        size_t m_deliveryDepth = 0;
+
+        /// <summary>
+        /// The number of live subscribers
+        /// </summary>
+        size_t m_size = 0;
+    };
+
+    /// <summary>
+    /// Identifies redundant copies of an event: the event's payload type, the kind of change it
+    /// reports and what it reports it about. Two events are only coalesced when every field is
+    /// equal, so unrelated events can never be merged.
+    /// </summary>
+    struct EventCoalescingKey final
+    {
+        /// <summary>
+        /// The type id of the event, filled in by Event
+        /// </summary>
+        RTTI::IdType m_typeId = 0;
+
+        /// <summary>
+        /// The kind of change the payload reports, empty if the payload has only one kind
+        /// </summary>
+        std::string m_subtype;
+
+        /// <summary>
+        /// Identifies what the payload reports the change about
+        /// </summary>
+        std::uint64_t m_target = 0;
+
+        bool operator==(const EventCoalescingKey& other) const
+        {
+            return m_typeId == other.m_typeId && m_target == other.m_target && m_subtype == other.m_subtype;
+        }
+
+        bool operator!=(const EventCoalescingKey& other) const
+        {
+            return !operator==(other);
+        }
+    };
+
+    template<>
+    struct DefaultHash<EventCoalescingKey>
+    {
+        inline size_t operator()(const EventCoalescingKey& key) const
+        {
+            size_t hash = std::hash<std::string>()(key.m_subtype);
+            hash ^= key.m_typeId + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<size_t>(key.m_target) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
     };
 
     /// <summary>
@@ -46,34 +284,44 @@ namespace FieaGameEngine
         /// </summary>
         /// <param name="subscribers"> The subscriber list that belongs to the derived
         /// class </param>
-        EventPublisher(const Vector<EventSubscriber*>& subscribers)
+        EventPublisher(SubscriberList& subscribers)
             : m_subscribersPtr(&subscribers) {}
 
         /// <summary>
-        /// Default copy constructor
+        /// Copy constructor. The copy starts with no references of its own.
         /// </summary>
         /// <param name="other"> The EventPublisher to copy </param>
-        EventPublisher(const EventPublisher& other) = default;
+        EventPublisher(const EventPublisher& other)
+            : RTTI(other), m_subscribersPtr(other.m_subscribersPtr) {}
 
         /// <summary>
-        /// Default move constructor
+        /// Move constructor. The new EventPublisher starts with no references of its own.
         /// </summary>
         /// <param name="other"> The EventPublisher to move </param>
-        EventPublisher(EventPublisher&& other) = default;
+        EventPublisher(EventPublisher&& other)
+            : RTTI(std::move(other)), m_subscribersPtr(other.m_subscribersPtr) {}
 
         /// <summary>
-        /// Default copy assignment
+        /// Copy assignment that leaves this EventPublisher's reference count alone
         /// </summary>
         /// <param name="other"> The EventPublisher to copy </param>
         /// <returns> A reference to the newly assigned EventPublisher </returns>
-        EventPublisher& operator=(const EventPublisher& other) = default;
+        EventPublisher& operator=(const EventPublisher& other)
+        {
+            m_subscribersPtr = other.m_subscribersPtr;
+            return *this;
+        }
 
         /// <summary>
-        /// Default move assignment
+        /// Move assignment that leaves this EventPublisher's reference count alone
         /// </summary>
         /// <param name="other"> The EventPublisher to move </param>
         /// <returns> A reference to the newly assigned EventPublisher </returns>
-        EventPublisher& operator=(EventPublisher&& other) = default;
+        EventPublisher& operator=(EventPublisher&& other)
+        {
+            m_subscribersPtr = other.m_subscribersPtr;
+            return *this;
+        }
 
         /// <summary>
         /// Default destructor 
@@ -81,17 +329,176 @@ namespace FieaGameEngine
         virtual ~EventPublisher() = 0 {};
 
         /// <summary>
-        /// Notifies all subscribers of this event
+        /// Gets the key that identifies redundant copies of this event. When an EventQueue has
+        /// coalescing turned on, events with equal keys that come due in the same update are
+        /// merged into one delivery.
+        /// </summary>
+        /// <param name="key"> Filled in with the coalescing key of this event </param>
+        /// <returns> True if this event can be coalesced, false if it never is </returns>
+        virtual bool CoalescingKey(EventCoalescingKey&) const { return false; }
+
+        /// <summary>
+        /// Gets the name of the payload this event carries, used to label traces
+        /// </summary>
+        /// <returns> The name of the payload type </returns>
+        virtual const char* PayloadName() const { return "EventPublisher"; }
+
+        /// <summary>
+        /// Notifies all subscribers of this event. Subscribers may subscribe and unsubscribe
+        /// while being notified; anyone who unsubscribes is skipped and anyone who subscribes
+        /// is first notified of the next event.
         /// </summary>
         void Deliver() const; 
 
+        /// <summary>
+        /// Gets the subscribers this event is delivered to
+        /// </summary>
+        /// <returns> The subscriber list that belongs to the derived class </returns>
+        SubscriberList& Subscribers() const { return *m_subscribersPtr; }
+
     protected:
         /// <summary>
         /// Pointer to the subscriber list that belongs to the derived class (Event)
         /// </summary>
-        const Vector<EventSubscriber*>* m_subscribersPtr;
+        SubscriberList* m_subscribersPtr;
+
+    private:
+        template <typename T>
+        friend class EventPtr;
+
+        /// <summary>
+        /// The number of EventPtrs referring to this EventPublisher. It isn't atomic, since
+        /// an event posted from another thread is handed over by moving its only reference,
+        /// after which only the thread that owns the EventQueue shares it.
+        /// </summary>
+        mutable std::uint32_t m_refCount = 0;
+    };
+
+    /// <summary>
+    /// Intrusive reference counted pointer to a heap allocated EventPublisher. The count
+    /// lives in the event itself, so sharing an event never allocates a control block, and
+    /// the event is deleted (back into its pool) once the last EventPtr lets go of it.
+    /// </summary>
+    /// <typeparam name="T"> The EventPublisher type pointed to </typeparam>
+    template <typename T>
+    class EventPtr final
+    {
+    public:
+        /// <summary>
+        /// Constructor that takes a reference to the given event, which must have been
+        /// allocated with new
+        /// </summary>
+        /// <param name="event"> The event to point to, or nullptr </param>
+        explicit EventPtr(T* event = nullptr)
+            : m_event(event)
+        {
+            AddReference();
+        }
+
+        /// <summary>
+        /// Copy constructor that takes another reference to the other's event
+        /// </summary>
+        /// <param name="other"> The EventPtr to copy </param>
+        EventPtr(const EventPtr& other)
+            : EventPtr(other.m_event) {}
+
+        /// <summary>
+        /// Move constructor that steals the other's reference
+        /// </summary>
+        /// <param name="other"> The EventPtr to move </param>
+        EventPtr(EventPtr&& other) noexcept
+            : m_event(other.m_event)
+        {
+            other.m_event = nullptr;
+        }
+
+        /// <summary>
+        /// Converting constructor from an EventPtr to a derived event type
+        /// </summary>
+        /// <param name="other"> The EventPtr to copy </param>
+        template <typename DerivedT>
+        EventPtr(const EventPtr<DerivedT>& other)
+            : EventPtr(other.Get()) {}
+
+        /// <summary>
+        /// Copy assignment that releases our event and takes a reference to the other's
+        /// </summary>
+        /// <param name="other"> The EventPtr to copy </param>
+        /// <returns> A reference to this EventPtr </returns>
+        EventPtr& operator=(const EventPtr& other)
+        {
+            EventPtr(other).Swap(*this);
+            return *this;
+        }
+
+        /// <summary>
+        /// Move assignment that releases our event and steals the other's reference
+        /// </summary>
+        /// <param name="other"> The EventPtr to move </param>
+        /// <returns> A reference to this EventPtr </returns>
+        EventPtr& operator=(EventPtr&& other) noexcept
+        {
+            EventPtr(std::move(other)).Swap(*this);
+            return *this;
+        }
+
+        /// <summary>
+        /// Destructor that releases our reference, deleting the event if it was the last one
+        /// </summary>
+        ~EventPtr()
+        {
+            if (m_event != nullptr && --m_event->m_refCount == 0)
+            {
+                delete m_event;
+            }
+        }
+
+        /// <summary>
+        /// Exchanges events with another EventPtr
+        /// </summary>
+        /// <param name="other"> The EventPtr to swap with </param>
+        void Swap(EventPtr& other) noexcept
+        {
+            std::swap(m_event, other.m_event);
+        }
+
+        /// <summary>
+        /// Gets the event pointed to
+        /// </summary>
+        /// <returns> The event, or nullptr </returns>
+        T* Get() const { return m_event; }
+
+        T& operator*() const { return *m_event; }
+        T* operator->() const { return m_event; }
+        explicit operator bool() const { return m_event != nullptr; }
+
+    private:
+        /// <summary>
+        /// Takes a reference to our event, if we have one
+        /// </summary>
+        void AddReference()
+        {
+            if (m_event != nullptr)
+            {
+                ++m_event->m_refCount;
+            }
+        }
+
+        /// <summary>
+        /// The event pointed to
+        /// </summary>
+        T* m_event;
     };
 
+    /// <summary>
+    /// Trait that detects whether a payload type has a bool CoalescingKey(EventCoalescingKey&) member
+    /// </summary>
+    template <typename T, typename = void>
+    struct HasCoalescingKey : std::false_type {};
+
+    template <typename T>
+    struct HasCoalescingKey<T, std::void_t<decltype(std::declval<const T&>().CoalescingKey(std::declval<EventCoalescingKey&>()))>> : std::true_type {};
+
     /// <summary>
     /// Templated event class that defines a specific event with a payload
     /// </summary>
@@ -101,6 +508,7 @@ namespace FieaGameEngine
     class Event : public EventPublisher
     {
         RTTI_DECLARATIONS(Event, EventPublisher);
+        POOL_DECLARATIONS(Event);
     public:
 
         /// <summary>
@@ -154,13 +562,10 @@ namespace FieaGameEngine
         /// is already subscribed, nothing happens
         /// </summary>
         /// <param name="subscriber"> The subscriber to subscribe </param>
-        static void Subscribe(EventSubscriber& subscriber)
+        /// <returns> A handle that can unsubscribe the subscriber without a lookup </returns>
+        static SubscriptionHandle Subscribe(EventSubscriber& subscriber)
         {
-            auto it = m_subscribers.Find(&subscriber);
-            if (it == m_subscribers.end())
-            {
-                m_subscribers.PushBack(&subscriber);
-            }
+            return m_subscribers.Subscribe(subscriber);
         }
 
         /// <summary>
@@ -171,7 +576,18 @@ namespace FieaGameEngine
         /// <returns> True if the subscriber was unsubscribed, false otherwise </returns>
         static bool Unsubscribe(EventSubscriber& subscriber)
         {
-            return m_subscribers.Remove(&subscriber);
+            return m_subscribers.Unsubscribe(subscriber);
+        }
+
+        /// <summary>
+        /// Unsubscribes the subscription the handle refers to. If it already ended, nothing
+        /// happens.
+        /// </summary>
+        /// <param name="handle"> The handle returned by Subscribe </param>
+        /// <returns> True if the subscriber was unsubscribed, false otherwise </returns>
+        static bool Unsubscribe(SubscriptionHandle handle)
+        {
+            return m_subscribers.Unsubscribe(handle);
         }
 
         /// <summary>
@@ -180,7 +596,15 @@ namespace FieaGameEngine
         static void UnsubscribeAll()
         {
             m_subscribers.Clear();
-            m_subscribers.ShrinkToFit();
+        }
+
+        /// <summary>
+        /// Gets the usage of the pool that events of this type are allocated from
+        /// </summary>
+        /// <returns> A snapshot of the pool's statistics </returns>
+        static PoolStats PoolStatistics()
+        {
+            return ObjectPool<Event>::Shared().Stats();
         }
 
         /// <summary>
@@ -192,12 +616,46 @@ namespace FieaGameEngine
             return m_message;
         }
 
+        /// <summary>
+        /// Gets the name of the payload type T
+        /// </summary>
+        /// <returns> The name of the payload type </returns>
+        const char* PayloadName() const override
+        {
+            return typeid(T).name();
+        }
+
+        /// <summary>
+        /// Gets the coalescing key of this event, which is the event type plus the subtype and
+        /// target the payload's own CoalescingKey fills in. Payloads without one are never
+        /// coalesced.
+        /// </summary>
+        /// <param name="key"> Filled in with the coalescing key of this event </param>
+        /// <returns> True if this event can be coalesced, false if it never is </returns>
+        bool CoalescingKey(EventCoalescingKey& key) const override
+        {
+            if constexpr (HasCoalescingKey<T>::value)
+            {
+                if (!m_message.CoalescingKey(key))
+                {
+                    return false;
+                }
+
+                key.m_typeId = TypeIdClass();
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
     private:
 
         /// <summary>
         /// Static subscriber list shared between all events of the same template type
         /// </summary>
-        inline static Vector<EventSubscriber*> m_subscribers{};
+        inline static SubscriberList m_subscribers{};
 
         /// <summary>
         /// The payload attached to this event
@@ -208,4 +666,16 @@ namespace FieaGameEngine
     template <typename T>
     RTTI_DEFINITIONS(Event<T>);
 
+    /// <summary>
+    /// Creates an event out of its type's pool, the pooled counterpart of std::make_shared
+    /// </summary>
+    /// <typeparam name="T"> The payload type of the event </typeparam>
+    /// <param name="args"> The arguments to construct the event with </param>
+    /// <returns> An EventPtr holding the only reference to the new event </returns>
+    template <typename T, typename... Args>
+    EventPtr<Event<T>> MakeEvent(Args&&... args)
+    {
+        return EventPtr<Event<T>>(new Event<T>(std::forward<Args>(args)...));
+    }
+
 }
\ No newline at end of file
@@ -10,11 +10,8 @@ namespace FieaGameEngine
     {
     }
 
-    const Vector<Signature> EventMessageAttributed::Signatures()
+    gsl::owner<EventMessageAttributed*> EventMessageAttributed::Clone() const
     {
-        return Vector<Signature>
-        {
-            { "Subtype", Datum::DatumType::String, 1, offsetof(EventMessageAttributed, m_subtype) }
-        };
+        return new EventMessageAttributed(*this);
     }
 }
\ No newline at end of file
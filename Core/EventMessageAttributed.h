@@ -2,6 +2,7 @@
 #include "Attributed.h"
 #include "WorldState.h"
 #include "TypeManager.h"
+#include <memory>
 
 namespace FieaGameEngine
 {
@@ -50,6 +51,12 @@ namespace FieaGameEngine
         /// </summary>
         virtual ~EventMessageAttributed() = default;
 
+        /// <summary>
+        /// Creates a clone of this EventMessageAttributed
+        /// </summary>
+        /// <returns> The newly heap-allocated EventMessageAttributed </returns>
+		gsl::owner<EventMessageAttributed*> Clone() const override;
+
 		/// <summary>
 		/// Gets the subtype of this message
 		/// </summary>
@@ -62,6 +69,36 @@ namespace FieaGameEngine
 		/// <param name="subtype"> The subtype to set this message to </param>
 		inline void SetSubtype(const std::string& subtype) { m_subtype = subtype; }
 
+		/// <summary>
+		/// Gets what this message is about, such as the Entity that sent it
+		/// </summary>
+		/// <returns> The target of this message, or nullptr if it has none </returns>
+		inline const Scope* GetTarget() const { return m_target; }
+
+		/// <summary>
+		/// Sets what this message is about. Only messages with a target are coalesced.
+		/// </summary>
+		/// <param name="target"> The target of this message, or nullptr for none </param>
+		inline void SetTarget(const Scope* target) { m_target = target; }
+
+		/// <summary>
+		/// Fills in the key that identifies redundant messages. Messages of the same subtype
+		/// about the same target are coalesced when the EventQueue has coalescing turned on.
+		/// </summary>
+		/// <param name="key"> The key to fill in </param>
+		/// <returns> True if this message has a target and can be coalesced, false otherwise </returns>
+		inline bool CoalescingKey(EventCoalescingKey& key) const
+		{
+			if (m_target == nullptr)
+			{
+				return false;
+			}
+
+			key.m_subtype = m_subtype;
+			key.m_target = reinterpret_cast<std::uintptr_t>(m_target);
+			return true;
+		}
+
 		/// <summary>
 		/// Gets the WorldState associated with this message
 		/// </summary>
@@ -74,13 +111,32 @@ namespace FieaGameEngine
 		/// <param name="worldState"> The WorldState to associate with this message </param>
 		inline void SetWorldState(WorldState& worldState) { m_worldState = &worldState; }
 
+		/// <summary>
+		/// Gets the attributes this message carries. The block is immutable and shared by every
+		/// copy of the message, so reactions read it in place.
+		/// </summary>
+		/// <returns> The attribute block, or nullptr if the message carries none </returns>
+		inline const Scope* GetPayload() const { return m_payload.get(); }
+
+		/// <summary>
+		/// Sets the attributes this message carries
+		/// </summary>
+		/// <param name="payload"> The attribute block to share </param>
+		inline void SetPayload(std::shared_ptr<const Scope> payload) { m_payload = std::move(payload); }
+
         /// <summary>
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 1> Signatures()
+		{
+			return std::array<StaticSignature, 1>
+			{ {
+				{ "Subtype", Datum::DatumType::String, 1, offsetof(EventMessageAttributed, m_subtype) }
+			} };
+		}
 
 	private:
 		/// <summary>
@@ -92,6 +148,16 @@ namespace FieaGameEngine
 		/// The WorldState associated with this message
 		/// </summary>
 		WorldState* m_worldState;
+
+		/// <summary>
+		/// What this message is about, nullptr if it isn't about anything in particular
+		/// </summary>
+		const Scope* m_target = nullptr;
+
+		/// <summary>
+		/// The attributes this message carries, shared with the ActionEvent that built them
+		/// </summary>
+		std::shared_ptr<const Scope> m_payload;
 	};
 }
 
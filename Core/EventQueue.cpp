@@ -1,58 +1,391 @@
 #include "pch.h"
 #include "EventQueue.h"
+#include "EventTrace.h"
+#include "EventReplay.h"
+#include "HashMap.h"
+#include "WorkerPool.h"
+#include <algorithm>
 
 namespace FieaGameEngine
 {
     EventQueue::EventQueue(GameTime& gameTime)
-        : m_gameTime(&gameTime)
+        : m_gameTime(&gameTime), m_publishedTime(gameTime.CurrentTime())
     {
     }
 
-    void EventQueue::Enqueue(std::shared_ptr<EventPublisher> e, std::chrono::milliseconds delay)
+    EventQueue::~EventQueue()
     {
-        QueueEntry entry{ std::move(e), delay, m_gameTime->CurrentTime() };
+        for (Producer* producer : m_producers)
+        {
+            delete producer;
+        }
+
+        delete m_workerPool;
+    }
+
+    void EventQueue::Enqueue(EventPtr<EventPublisher> e, std::chrono::milliseconds delay)
+    {
+        auto currentTime = m_gameTime->CurrentTime();
+        m_publishedTime.store(currentTime, std::memory_order_release);
+
+        if (EventTrace::IsEnabled())
+        {
+            EventTrace::RecordEnqueue(*e, delay);
+        }
+        if (m_recording != nullptr)
+        {
+            m_recording->Record(e, currentTime, delay);
+        }
+
+        QueueEntry entry{ std::move(e), currentTime + delay, currentTime, OwnerProducerId, m_nextSequence++ };
         m_queueBuffer.PushBack(std::move(entry));
     }
 
+    EventQueue::Producer& EventQueue::CreateProducer()
+    {
+        Producer* producer = new Producer(*this, static_cast<std::uint32_t>(m_producers.Size() + 1));
+        m_producers.PushBack(producer);
+        return *producer;
+    }
+
     void EventQueue::Clear()
     {
         m_events.Clear();
         m_queueBuffer.Clear();
+
+        for (Producer* producer : m_producers)
+        {
+            std::lock_guard<std::mutex> lock(producer->m_mutex);
+            producer->m_buffer.Clear();
+        }
     }
 
     bool EventQueue::IsEmpty() const
     {
-       return m_events.IsEmpty() && m_queueBuffer.IsEmpty();
+       return Size() == 0;
     }
 
     size_t EventQueue::Size() const
     {
-        return m_events.Size() + m_queueBuffer.Size();
+        size_t size = m_events.Size() + m_queueBuffer.Size();
+
+        for (Producer* producer : m_producers)
+        {
+            std::lock_guard<std::mutex> lock(producer->m_mutex);
+            size += producer->m_buffer.Size();
+        }
+
+        return size;
     }
 
     void EventQueue::Update()
     {
-        // Add all queued events sitting in the buffer to our event queue, then clear the buffer
+        auto currentTime = m_gameTime->CurrentTime();
+        m_publishedTime.store(currentTime, std::memory_order_release);
+
+        // Move all queued events sitting in the buffers into the heap, then clear the buffers. The
+        // heap orders them, so the order the buffers are merged in doesn't matter.
         for (QueueEntry& entry : m_queueBuffer)
         {
-            m_events.PushBack(entry);
+            PushHeap(std::move(entry));
         }
         m_queueBuffer.Clear();
 
-        // Partition our events into expired and not expired
-        auto it = std::partition(m_events.begin(), m_events.end(), 
-            [this](QueueEntry entry) { return !entry.IsExpired(m_gameTime->CurrentTime()); });
+        for (Producer* producer : m_producers)
+        {
+            std::lock_guard<std::mutex> lock(producer->m_mutex);
+            for (QueueEntry& entry : producer->m_buffer)
+            {
+                PushHeap(std::move(entry));
+            }
+            producer->m_buffer.Clear();
+        }
+
+        // Only the events that are due get touched. Anything enqueued while delivering goes to
+        // a buffer, so it waits until the next update.
+        if (m_deliveryMode == DeliveryMode::Serial && !m_isCoalescing)
+        {
+            while (!m_events.IsEmpty() && m_events.Front().IsExpired(currentTime))
+            {
+                QueueEntry entry = PopHeap();
+                entry.m_eventPublisher->Deliver();
+                ++m_stats.m_delivered;
+            }
+
+            return;
+        }
 
-        // Iterate through the list of event publishers and deliver the expired ones
-        for (auto i = it; i != m_events.end(); ++i)
+        // Coalescing and parallel delivery both need to see every due event up front
+        while (!m_events.IsEmpty() && m_events.Front().IsExpired(currentTime))
         {
-            i->m_eventPublisher->Deliver();
+            m_deliveryBatch.PushBack(PopHeap());
         }
 
-        // Delete all the delivered events if there were any
-        if (it != m_events.end())
+        if (m_isCoalescing)
+        {
+            Coalesce(m_deliveryBatch);
+        }
+
+        if (m_deliveryMode == DeliveryMode::Parallel)
+        {
+            DeliverParallel(m_deliveryBatch);
+        }
+        else
         {
-            m_events.Remove(it, m_events.end());
+            for (const QueueEntry& entry : m_deliveryBatch)
+            {
+                entry.m_eventPublisher->Deliver();
+            }
         }
+
+        m_stats.m_delivered += m_deliveryBatch.Size();
+        m_deliveryBatch.Clear();
+    }
+
+    void EventQueue::SetCoalescing(bool enabled, CoalescingReducer reducer)
+    {
+        m_isCoalescing = enabled;
+        m_reducer = std::move(reducer);
+    }
+
+    void EventQueue::Coalesce(Vector<QueueEntry>& batch)
+    {
+        size_t kept = 0;
+        EventCoalescingKey key;
+
+        for (size_t i = 0; i < batch.Size(); ++i)
+        {
+            if (batch[i].m_eventPublisher->CoalescingKey(key))
+            {
+                auto [it, wasInserted] = m_coalescingIndex.Insert(std::make_pair(key, kept));
+
+                // Merge into the first event with this key, which keeps its place in the batch
+                if (!wasInserted)
+                {
+                    QueueEntry& first = batch[it->second];
+                    if (m_reducer)
+                    {
+                        first.m_eventPublisher = m_reducer(first.m_eventPublisher, batch[i].m_eventPublisher);
+                    }
+                    else
+                    {
+                        first.m_eventPublisher = std::move(batch[i].m_eventPublisher);
+                    }
+
+                    ++m_stats.m_coalesced;
+                    continue;
+                }
+            }
+
+            if (kept != i)
+            {
+                batch[kept] = std::move(batch[i]);
+            }
+            ++kept;
+        }
+
+        while (batch.Size() > kept)
+        {
+            batch.PopBack();
+        }
+
+        m_coalescingIndex.Clear();
+    }
+
+    void EventQueue::DeliverParallel(const Vector<QueueEntry>& batch)
+    {
+        // Every list stays marked as delivering until all groups are done, matching Deliver,
+        // even if a subscriber throws
+        struct BatchDeliveryGuard
+        {
+            const Vector<QueueEntry>& m_batch;
+            size_t m_begunCount = 0;
+
+            ~BatchDeliveryGuard()
+            {
+                for (size_t i = 0; i < m_begunCount; ++i)
+                {
+                    m_batch[i].m_eventPublisher->Subscribers().EndDelivery();
+                }
+            }
+        };
+        BatchDeliveryGuard deliveryGuard{ batch };
+
+        // Sort every notification into its subscriber's affinity group, keeping batch order within
+        // each. Workers only ever see these snapshots, never the subscriber lists themselves.
+        Vector<Delivery> mainThreadDeliveries;
+        Vector<Delivery> threadSafeDeliveries;
+        HashMap<std::uint32_t, Vector<Delivery>> groupDeliveries;
+
+        for (const QueueEntry& entry : batch)
+        {
+            SubscriberList& subscribers = entry.m_eventPublisher->Subscribers();
+            subscribers.BeginDelivery();
+            ++deliveryGuard.m_begunCount;
+
+            for (size_t slot = 0; slot < subscribers.SlotCount(); ++slot)
+            {
+                EventSubscriber* subscriber = subscribers.SlotAt(slot);
+                if (subscriber == nullptr)
+                {
+                    continue;
+                }
+
+                Delivery delivery{ entry.m_eventPublisher.Get(), subscriber, slot };
+
+                std::uint32_t group = subscriber->AffinityGroup();
+                if (group == EventSubscriber::MainThreadGroup)
+                {
+                    mainThreadDeliveries.PushBack(delivery);
+                }
+                else if (group == EventSubscriber::ThreadSafeGroup)
+                {
+                    threadSafeDeliveries.PushBack(delivery);
+                }
+                else
+                {
+                    groupDeliveries[group].PushBack(delivery);
+                }
+            }
+        }
+
+        bool isTracing = EventTrace::IsEnabled();
+        auto deliverRange = [isTracing](const Vector<Delivery>& deliveries, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Delivery& delivery = deliveries[i];
+                EventSubscriber* subscriber = delivery.m_subscriber;
+
+                // Skip anyone who unsubscribed meanwhile
+                if (delivery.m_event->Subscribers().SlotAt(delivery.m_slot) != subscriber)
+                {
+                    continue;
+                }
+
+                if (isTracing)
+                {
+                    auto notifyStart = EventTrace::Clock::now();
+                    subscriber->Notify(*delivery.m_event);
+                    EventTrace::RecordNotify(*delivery.m_event, notifyStart, EventTrace::Clock::now());
+                }
+                else
+                {
+                    subscriber->Notify(*delivery.m_event);
+                }
+            }
+        };
+
+        // The main thread group goes first and alone, since it may unsubscribe or destroy
+        // subscribers of any group. After that the lists don't change until every task is done.
+        deliverRange(mainThreadDeliveries, 0, mainThreadDeliveries.Size());
+
+        if (groupDeliveries.Size() == 0 && threadSafeDeliveries.IsEmpty())
+        {
+            return;
+        }
+
+        if (m_workerPool == nullptr)
+        {
+            m_workerPool = new WorkerPool();
+        }
+
+        // Each group is one task, and the thread-safe notifications are one chunk per thread
+        Vector<const Vector<Delivery>*> groupLists;
+        groupLists.Reserve(groupDeliveries.Size());
+        for (const auto& [group, deliveries] : groupDeliveries)
+        {
+            groupLists.PushBack(&deliveries);
+        }
+
+        size_t chunkCount = threadSafeDeliveries.IsEmpty() ? 0 : m_workerPool->ThreadCount();
+        size_t chunkSize = (threadSafeDeliveries.Size() + chunkCount - 1) / std::max<size_t>(chunkCount, 1);
+
+        m_workerPool->Run(groupLists.Size() + chunkCount, [&groupLists, &threadSafeDeliveries, &deliverRange, chunkSize](size_t task)
+            {
+                if (task < groupLists.Size())
+                {
+                    deliverRange(*groupLists[task], 0, groupLists[task]->Size());
+                    return;
+                }
+
+                size_t begin = std::min((task - groupLists.Size()) * chunkSize, threadSafeDeliveries.Size());
+                size_t end = std::min(begin + chunkSize, threadSafeDeliveries.Size());
+                deliverRange(threadSafeDeliveries, begin, end);
+            });
+    }
+
+    void EventQueue::PushHeap(QueueEntry&& entry)
+    {
+        m_events.PushBack(std::move(entry));
+
+        // Sift the new entry up until its parent is due before it
+        size_t index = m_events.Size() - 1;
+        while (index > 0)
+        {
+            size_t parent = (index - 1) / 2;
+            if (!m_events[index].IsDueBefore(m_events[parent]))
+            {
+                break;
+            }
+
+            std::swap(m_events[index], m_events[parent]);
+            index = parent;
+        }
+    }
+
+    EventQueue::QueueEntry EventQueue::PopHeap()
+    {
+        QueueEntry front = std::move(m_events.Front());
+
+        std::swap(m_events.Front(), m_events.Back());
+        m_events.PopBack();
+
+        // Sift the moved entry down until both children are due after it
+        size_t index = 0;
+        size_t size = m_events.Size();
+        for (;;)
+        {
+            size_t earliest = index;
+            size_t left = (index * 2) + 1;
+            size_t right = left + 1;
+
+            if (left < size && m_events[left].IsDueBefore(m_events[earliest]))
+            {
+                earliest = left;
+            }
+            if (right < size && m_events[right].IsDueBefore(m_events[earliest]))
+            {
+                earliest = right;
+            }
+
+            if (earliest == index)
+            {
+                break;
+            }
+
+            std::swap(m_events[index], m_events[earliest]);
+            index = earliest;
+        }
+
+        return front;
+    }
+
+    void EventQueue::Producer::Enqueue(EventPtr<EventPublisher> e, std::chrono::milliseconds delay)
+    {
+        auto currentTime = m_queue->m_publishedTime.load(std::memory_order_acquire);
+
+        if (EventTrace::IsEnabled())
+        {
+            EventTrace::RecordEnqueue(*e, delay);
+        }
+        if (m_queue->m_recording != nullptr)
+        {
+            m_queue->m_recording->Record(e, currentTime, delay);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        QueueEntry entry{ std::move(e), currentTime + delay, currentTime, m_id, m_nextSequence++ };
+        m_buffer.PushBack(std::move(entry));
     }
-}
\ No newline at end of file
+}
@@ -1,21 +1,74 @@
 #pragma once
+#include <atomic>
 #include <chrono>
-#include <memory>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <gsl/gsl>
 #include "GameTime.h"
 #include "RTTI.h"
 #include "Vector.h"
 #include "SList.h"
 #include "Event.h"
+#include "HashMap.h"
 
 namespace FieaGameEngine
 {
+    class EventRecording;
+    class WorkerPool;
+
+    /// <summary>
+    /// Running totals of what an EventQueue has delivered
+    /// </summary>
+    struct EventQueueStats final
+    {
+        /// <summary>
+        /// Events that have been delivered
+        /// </summary>
+        size_t m_delivered = 0;
+
+        /// <summary>
+        /// Events that were merged into another event instead of being delivered
+        /// </summary>
+        size_t m_coalesced = 0;
+    };
+
     /// <summary>
     /// EventQueue class that handles queueing events with various delays and managing
-    /// when to deliver them.
+    /// when to deliver them. Pending events are kept in a binary min-heap ordered by
+    /// expiry time, so each update only touches the events that are due. Events are
+    /// delivered on the thread that owns the queue, but other threads can post to it
+    /// through a Producer.
     /// </summary>
 	class EventQueue final
 	{
     public:
+        class Producer;
+
+        /// <summary>
+        /// Merges two events with the same coalescing key into the one to deliver. The earlier
+        /// event is the result of any previous merges in the same update.
+        /// </summary>
+        using CoalescingReducer = std::function<EventPtr<EventPublisher>(const EventPtr<EventPublisher>& earlier, const EventPtr<EventPublisher>& later)>;
+
+        /// <summary>
+        /// How expired events are delivered
+        /// </summary>
+        enum class DeliveryMode
+        {
+            /// <summary>
+            /// Every subscriber is notified on the owning thread, in order. Fully deterministic.
+            /// </summary>
+            Serial,
+
+            /// <summary>
+            /// Each batch of expired events fans out across worker threads by subscriber affinity
+            /// group. Subscribers in the main thread group are still notified on the owning thread.
+            /// </summary>
+            Parallel
+        };
+
         /// <summary>
         /// Constructor that creates a copy of the passed in GameTime
         /// </summary>
@@ -25,24 +78,13 @@ namespace FieaGameEngine
 
         EventQueue(const EventQueue& other) = delete;
         EventQueue& operator=(const EventQueue& other) = delete;
+        EventQueue(EventQueue&& other) = delete;
+        EventQueue& operator=(EventQueue&& other) = delete;
 
         /// <summary>
-        /// Default move constructor
-        /// </summary>
-        /// <param name="other"> The EventQueue to move </param>
-        EventQueue(EventQueue&& other) = default;
-
-        /// <summary>
-        /// Default move assignment
+        /// Destructor that deletes every Producer made by this queue and stops its workers
         /// </summary>
-        /// <param name="other"> The EventQueue to move </param>
-        /// <returns> A reference to the newly assigned EventQueue </returns>
-        EventQueue& operator=(EventQueue&& other) = default;
-
-        /// <summary>
-        /// Default destructor 
-        /// </summary>
-        ~EventQueue() = default;
+        ~EventQueue();
 
         /// <summary>
         /// Updates the current GameTime and calls Deliver on any queued events that
@@ -54,10 +96,64 @@ namespace FieaGameEngine
         /// Enqueues the passed in event with an optional delay before it is delivered. If this
         /// event is being enqueued as a result of a Notify from another event, it won't be delivered
         /// until at least 1 tick later.
+        /// Only call this from the thread that owns the queue; other threads use a Producer.
         /// </summary>
-        /// <param name="e"> The event to enqueue </param>
+        /// <param name="e"> The event to enqueue, usually made with MakeEvent </param>
         /// <param name="delay"> Optional delay before this event is delivered </param>
-        void Enqueue(std::shared_ptr<EventPublisher> e, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+        void Enqueue(EventPtr<EventPublisher> e, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+        /// <summary>
+        /// Creates a Producer that another thread can use to post events to this queue. Call
+        /// this from the owning thread, in a fixed order, since Producers are numbered in the
+        /// order they are created and that number breaks ties between events.
+        /// </summary>
+        /// <returns> A reference to the new Producer, which lives as long as this queue </returns>
+        Producer& CreateProducer();
+
+        /// <summary>
+        /// Sets how expired events are delivered. Subscribers notified off the owning thread
+        /// must post any events of their own through a Producer, and must not subscribe or
+        /// unsubscribe anyone. In parallel mode the main thread group is notified first, on the
+        /// owning thread, and may subscribe, unsubscribe and destroy subscribers as usual.
+        /// The other groups are notified after that, while nothing changes the subscriber lists,
+        /// so anyone unsubscribed by then is skipped.
+        /// </summary>
+        /// <param name="mode"> The delivery mode to use from the next update on </param>
+        void SetDeliveryMode(DeliveryMode mode) { m_deliveryMode = mode; }
+
+        /// <summary>
+        /// Gets how expired events are delivered
+        /// </summary>
+        /// <returns> The current delivery mode </returns>
+        DeliveryMode GetDeliveryMode() const { return m_deliveryMode; }
+
+        /// <summary>
+        /// Turns coalescing on or off. While it is on, events that come due in the same update
+        /// and share a coalescing key are merged into one, delivered where the first of them
+        /// would have been.
+        /// </summary>
+        /// <param name="enabled"> Whether to coalesce events </param>
+        /// <param name="reducer"> Merges two events into one. If empty, the later event wins. </param>
+        void SetCoalescing(bool enabled, CoalescingReducer reducer = CoalescingReducer());
+
+        /// <summary>
+        /// Gets whether events are being coalesced
+        /// </summary>
+        /// <returns> True if coalescing is on, false otherwise </returns>
+        bool IsCoalescing() const { return m_isCoalescing; }
+
+        /// <summary>
+        /// Gets the running totals of delivered and coalesced events
+        /// </summary>
+        /// <returns> The statistics of this queue </returns>
+        const EventQueueStats& Stats() const { return m_stats; }
+
+        /// <summary>
+        /// Sets the recording that every enqueued event is added to, so the stream can be
+        /// replayed later. Set it before any Producer starts posting.
+        /// </summary>
+        /// <param name="recording"> The recording to add to, or nullptr to stop recording </param>
+        void SetRecording(EventRecording* recording) { m_recording = recording; }
 
         /// <summary>
         /// Clears all events out of the queue (they will not be delivered)
@@ -77,31 +173,144 @@ namespace FieaGameEngine
         size_t Size() const;
 
     private:
+        /// <summary>
+        /// The producer id of events enqueued by the owning thread
+        /// </summary>
+        static const std::uint32_t OwnerProducerId = 0;
+
         /// <summary>
         /// Private QueueEntry struct used to keep track of events in the queue
         /// </summary>
         struct QueueEntry
         {
-            std::shared_ptr<EventPublisher> m_eventPublisher;
-            std::chrono::milliseconds m_delay;
-            std::chrono::high_resolution_clock::time_point m_timeEnqueued;
+            EventPtr<EventPublisher> m_eventPublisher;
+            std::chrono::high_resolution_clock::time_point m_expiryTime;
+            std::chrono::high_resolution_clock::time_point m_enqueueTime;
+            std::uint32_t m_producerId;
+            std::uint64_t m_sequence;
 
             inline bool IsExpired(std::chrono::high_resolution_clock::time_point currentTime) const
             {
-                return (m_timeEnqueued + m_delay) <= currentTime;
+                return m_expiryTime <= currentTime;
             }
+
+            /// <summary>
+            /// Heap ordering: earlier expiry first, then earlier enqueue time, then lower producer
+            /// id, then enqueue order within a producer. This doesn't depend on how the threads
+            /// interleaved, so delivery order is deterministic.
+            /// </summary>
+            inline bool IsDueBefore(const QueueEntry& other) const
+            {
+                return std::tie(m_expiryTime, m_enqueueTime, m_producerId, m_sequence) <
+                    std::tie(other.m_expiryTime, other.m_enqueueTime, other.m_producerId, other.m_sequence);
+            }
+        };
+
+        /// <summary>
+        /// One subscriber to notify of one event during parallel delivery
+        /// </summary>
+        struct Delivery
+        {
+            const EventPublisher* m_event;
+            EventSubscriber* m_subscriber;
+            size_t m_slot;
         };
 
+        /// <summary>
+        /// Merges the events in a batch that share a coalescing key, compacting the batch
+        /// </summary>
+        /// <param name="batch"> The expired events, in the order they are due </param>
+        void Coalesce(Vector<QueueEntry>& batch);
+
+        /// <summary>
+        /// Delivers a batch of expired events. The main thread group is notified on this thread
+        /// first, then every other affinity group's subscribers are notified in batch order as
+        /// one task each on the worker pool.
+        /// </summary>
+        /// <param name="batch"> The expired events, in the order they are due </param>
+        void DeliverParallel(const Vector<QueueEntry>& batch);
+
+        /// <summary>
+        /// Adds an entry to the heap and restores the heap order
+        /// </summary>
+        /// <param name="entry"> The entry to add </param>
+        void PushHeap(QueueEntry&& entry);
+
+        /// <summary>
+        /// Removes the entry that is due first from the heap and restores the heap order
+        /// </summary>
+        /// <returns> The removed entry </returns>
+        QueueEntry PopHeap();
+
         /// <summary>
         /// Internal GameTime used to keep track of elapsed time
         /// </summary>
         GameTime* m_gameTime;
 
         /// <summary>
-        /// Internal event queue used to keep track of all events that have been added
+        /// Internal event queue used to keep track of all events that have been added. It is
+        /// a binary min-heap, so the front entry is always the next one due.
         /// </summary>
         Vector<QueueEntry> m_events;
 
+        /// <summary>
+        /// Incremented for every event the owning thread enqueues to keep delivery order stable
+        /// </summary>
+        std::uint64_t m_nextSequence = 0;
+
+        /// <summary>
+        /// The latest game time the owning thread has seen, which Producers stamp their events
+        /// with since they can't read the GameTime safely
+        /// </summary>
+        std::atomic<std::chrono::high_resolution_clock::time_point> m_publishedTime;
+
+        /// <summary>
+        /// How expired events are delivered
+        /// </summary>
+        DeliveryMode m_deliveryMode = DeliveryMode::Serial;
+
+        /// <summary>
+        /// Threads that parallel delivery runs on, started by the first parallel update and
+        /// reused by every one after it
+        /// </summary>
+        gsl::owner<WorkerPool*> m_workerPool = nullptr;
+
+        /// <summary>
+        /// Expired events gathered for coalescing or parallel delivery, kept around so its
+        /// memory is reused
+        /// </summary>
+        Vector<QueueEntry> m_deliveryBatch;
+
+        /// <summary>
+        /// Whether events are being coalesced
+        /// </summary>
+        bool m_isCoalescing = false;
+
+        /// <summary>
+        /// Merges coalesced events, or empty for last writer wins
+        /// </summary>
+        CoalescingReducer m_reducer;
+
+        /// <summary>
+        /// Maps each coalescing key seen during an update to its slot in the batch
+        /// </summary>
+        HashMap<EventCoalescingKey, size_t> m_coalescingIndex;
+
+        /// <summary>
+        /// Running totals of delivered and coalesced events
+        /// </summary>
+        EventQueueStats m_stats;
+
+        /// <summary>
+        /// The recording enqueued events are added to, if any
+        /// </summary>
+        EventRecording* m_recording = nullptr;
+
+        /// <summary>
+        /// Every Producer made by this queue, in the order they were created
+        /// </summary>
+        Vector<gsl::owner<Producer*>> m_producers;
+
         /// <summary>
         /// Queue buffer used just in case events are added to the queue during the iteration
         /// through events. All entries will be transferred to the event queue at the start of
@@ -109,4 +318,69 @@ namespace FieaGameEngine
         /// </summary>
         Vector<QueueEntry> m_queueBuffer;
 	};
+
+    /// <summary>
+    /// Handle that lets one other thread post events to an EventQueue. Each Producer has its
+    /// own buffer behind its own lock, so producers never contend with each other, and the
+    /// owning thread merges every buffer into the queue at the start of each update.
+    /// </summary>
+    class EventQueue::Producer final
+    {
+    public:
+        Producer(const Producer& other) = delete;
+        Producer(Producer&& other) = delete;
+        Producer& operator=(const Producer& other) = delete;
+        Producer& operator=(Producer&& other) = delete;
+
+        /// <summary>
+        /// Enqueues the passed in event with an optional delay before it is delivered on the
+        /// owning thread. Hand the event over by moving the only reference to it in, since its
+        /// reference count isn't atomic.
+        /// </summary>
+        /// <param name="e"> The event to enqueue, usually made with MakeEvent </param>
+        /// <param name="delay"> Optional delay before this event is delivered </param>
+        void Enqueue(EventPtr<EventPublisher> e, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+
+        /// <summary>
+        /// Gets the id that orders this Producer's events against other producers'
+        /// </summary>
+        /// <returns> The id of this Producer </returns>
+        std::uint32_t Id() const { return m_id; }
+
+    private:
+        friend class EventQueue;
+
+        /// <summary>
+        /// Constructor used by EventQueue::CreateProducer
+        /// </summary>
+        /// <param name="queue"> The queue this Producer posts to </param>
+        /// <param name="id"> The id of this Producer </param>
+        Producer(EventQueue& queue, std::uint32_t id)
+            : m_queue(&queue), m_id(id) {}
+
+        /// <summary>
+        /// The queue this Producer posts to
+        /// </summary>
+        EventQueue* m_queue;
+
+        /// <summary>
+        /// The id of this Producer
+        /// </summary>
+        std::uint32_t m_id;
+
+        /// <summary>
+        /// Incremented for every event this Producer enqueues
+        /// </summary>
+        std::uint64_t m_nextSequence = 0;
+
+        /// <summary>
+        /// Events posted since the last update
+        /// </summary>
+        Vector<QueueEntry> m_buffer;
+
+        /// <summary>
+        /// Guards the buffer between this Producer's thread and the owning thread
+        /// </summary>
+        std::mutex m_mutex;
+    };
 }
@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "EventTrace.h"
+#include "Event.h"
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace FieaGameEngine
+{
+    namespace
+    {
+        const char* const RecordTypeNames[] =
+        {
+            "Enqueue",
+            "Deliver",
+            "Notify"
+        };
+
+        std::uint32_t CurrentThreadId()
+        {
+            thread_local const std::uint32_t threadId = static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            return threadId;
+        }
+
+        double ToMicroseconds(std::uint64_t nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) / 1000.0;
+        }
+    }
+
+    std::atomic<bool> EventTrace::m_isEnabled{ false };
+    std::atomic<EventTrace::Buffer*> EventTrace::m_buffer{ nullptr };
+    Vector<EventTrace::RetiredBuffer> EventTrace::m_retired;
+
+    EventTrace::Buffer::Buffer(size_t capacity)
+        : m_slots(new Slot[capacity]), m_capacity(capacity), m_origin(Clock::now())
+    {
+        for (size_t i = 0; i < m_capacity; ++i)
+        {
+            m_slots[i].m_sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    EventTrace::Buffer::~Buffer()
+    {
+        delete[] m_slots;
+    }
+
+    void EventTrace::Start(size_t capacity)
+    {
+        Replace(new Buffer((capacity > 0) ? capacity : DefaultCapacity));
+        m_isEnabled.store(true, std::memory_order_release);
+    }
+
+    void EventTrace::Stop()
+    {
+        m_isEnabled.store(false, std::memory_order_release);
+    }
+
+    void EventTrace::Clear()
+    {
+        Stop();
+        Replace(nullptr);
+    }
+
+    void EventTrace::RecordEnqueue(const EventPublisher& event, std::chrono::milliseconds delay)
+    {
+        EventTraceRecord record;
+        record.m_type = EventTraceRecord::RecordType::Enqueue;
+        record.m_eventName = event.PayloadName();
+        record.m_delay = delay.count();
+        Write(record, Clock::now());
+    }
+
+    void EventTrace::RecordDeliver(const EventPublisher& event, size_t subscriberCount, Clock::time_point start, Clock::time_point end)
+    {
+        EventTraceRecord record;
+        record.m_type = EventTraceRecord::RecordType::Deliver;
+        record.m_eventName = event.PayloadName();
+        record.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        record.m_subscriberCount = static_cast<std::uint32_t>(subscriberCount);
+        Write(record, start);
+    }
+
+    void EventTrace::RecordNotify(const EventPublisher& event, Clock::time_point start, Clock::time_point end)
+    {
+        EventTraceRecord record;
+        record.m_type = EventTraceRecord::RecordType::Notify;
+        record.m_eventName = event.PayloadName();
+        record.m_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        Write(record, start);
+    }
+
+    Vector<EventTraceRecord> EventTrace::Records()
+    {
+        Vector<EventTraceRecord> records;
+
+        ReadEpoch::Guard guard;
+        const Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        if (buffer == nullptr)
+        {
+            return records;
+        }
+
+        std::uint64_t head = buffer->m_head.load(std::memory_order_acquire);
+        std::uint64_t first = (head > buffer->m_capacity) ? head - buffer->m_capacity : 0;
+        records.Reserve(static_cast<size_t>(head - first));
+
+        for (std::uint64_t index = first; index < head; ++index)
+        {
+            const Slot& slot = buffer->m_slots[index % buffer->m_capacity];
+
+            // Only take the record if it was finished before and after we copied it
+            std::uint64_t expected = (index + 1) * 2;
+            if (slot.m_sequence.load(std::memory_order_acquire) != expected)
+            {
+                continue;
+            }
+
+            EventTraceRecord record = slot.m_record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_sequence.load(std::memory_order_relaxed) == expected)
+            {
+                records.PushBack(record);
+            }
+        }
+
+        return records;
+    }
+
+    Json::Value EventTrace::ToChromeTrace()
+    {
+        Json::Value events(Json::arrayValue);
+
+        for (const EventTraceRecord& record : Records())
+        {
+            Json::Value event(Json::objectValue);
+            event["name"] = (record.m_eventName != nullptr) ? record.m_eventName : "Unknown";
+            event["cat"] = RecordTypeNames[static_cast<size_t>(record.m_type)];
+            event["ts"] = ToMicroseconds(record.m_timestamp);
+            event["pid"] = 0;
+            event["tid"] = record.m_threadId;
+
+            Json::Value args(Json::objectValue);
+            if (record.m_type == EventTraceRecord::RecordType::Enqueue)
+            {
+                // Enqueues are instants, everything else spans its duration
+                event["ph"] = "i";
+                event["s"] = "t";
+                args["DelayMs"] = static_cast<Json::Value::Int64>(record.m_delay);
+            }
+            else
+            {
+                event["ph"] = "X";
+                event["dur"] = ToMicroseconds(record.m_duration);
+                if (record.m_type == EventTraceRecord::RecordType::Deliver)
+                {
+                    args["SubscriberCount"] = record.m_subscriberCount;
+                }
+            }
+            event["args"] = args;
+
+            events.append(event);
+        }
+
+        Json::Value root(Json::objectValue);
+        root["traceEvents"] = events;
+        root["displayTimeUnit"] = "ns";
+        return root;
+    }
+
+    void EventTrace::DumpChromeTraceToFile(const std::string& fileName)
+    {
+        std::ofstream file(fileName);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open the file to dump the event trace into!");
+        }
+
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "";
+        file << Json::writeString(builder, ToChromeTrace());
+    }
+
+    void EventTrace::Write(EventTraceRecord record, Clock::time_point time)
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        // Start or Clear may swap the buffer out at any moment, but won't free it while we're in the epoch
+        ReadEpoch::Guard guard;
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        record.m_timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(time - buffer->m_origin).count();
+        record.m_threadId = CurrentThreadId();
+
+        std::uint64_t index = buffer->m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = buffer->m_slots[index % buffer->m_capacity];
+
+        slot.m_sequence.store((index * 2) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.m_record = record;
+        slot.m_sequence.store((index + 1) * 2, std::memory_order_release);
+    }
+
+    void EventTrace::Replace(gsl::owner<Buffer*> buffer)
+    {
+        const Buffer* previous = m_buffer.exchange(buffer);
+        if (previous != nullptr)
+        {
+            m_retired.PushBack({ previous, ReadEpoch::Retire() });
+        }
+
+        // Buffers are retired in order, so the reclaimable ones are at the front
+        size_t reclaimed = 0;
+        while (reclaimed < m_retired.Size() && ReadEpoch::IsReclaimable(m_retired[reclaimed].m_tag))
+        {
+            delete m_retired[reclaimed].m_buffer;
+            ++reclaimed;
+        }
+
+        if (reclaimed > 0)
+        {
+            m_retired.Remove(m_retired.begin(), m_retired.begin() + reclaimed);
+        }
+    }
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <json/json.h>
+#include <gsl/gsl>
+#include "Vector.h"
+#include "ReadEpoch.h"
+
+namespace FieaGameEngine
+{
+    class EventPublisher;
+
+    /// <summary>
+    /// One thing the event system did, as captured by EventTrace
+    /// </summary>
+    struct EventTraceRecord final
+    {
+        /// <summary>
+        /// What kind of thing happened
+        /// </summary>
+        enum class RecordType : std::uint8_t
+        {
+            Enqueue,
+            Deliver,
+            Notify
+        };
+
+        /// <summary>
+        /// What kind of thing happened
+        /// </summary>
+        RecordType m_type = RecordType::Enqueue;
+
+        /// <summary>
+        /// The name of the event's payload type
+        /// </summary>
+        const char* m_eventName = nullptr;
+
+        /// <summary>
+        /// When it happened, in nanoseconds since tracing started
+        /// </summary>
+        std::uint64_t m_timestamp = 0;
+
+        /// <summary>
+        /// How long a delivery or Notify took in nanoseconds, 0 for an enqueue
+        /// </summary>
+        std::uint64_t m_duration = 0;
+
+        /// <summary>
+        /// The delay an event was enqueued with in milliseconds
+        /// </summary>
+        std::int64_t m_delay = 0;
+
+        /// <summary>
+        /// The number of subscribers a delivery notified
+        /// </summary>
+        std::uint32_t m_subscriberCount = 0;
+
+        /// <summary>
+        /// Identifies the thread it happened on
+        /// </summary>
+        std::uint32_t m_threadId = 0;
+    };
+
+    /// <summary>
+    /// Static instrumentation layer for the event system. While tracing, EventQueue and
+    /// EventPublisher::Deliver write a record for every enqueue, delivery and Notify into a
+    /// fixed size ring buffer. Writers claim slots with a single atomic increment, so any
+    /// thread can record without locking, and the oldest records are overwritten once the
+    /// buffer is full. A buffer replaced by Start or Clear is retired and freed only once
+    /// no writer or reader can still be using it. The records can be exported in the Chrome trace event format, which
+    /// chrome://tracing and Perfetto can open.
+    /// </summary>
+    class EventTrace final
+    {
+    public:
+        /// <summary>
+        /// Clock used to time everything that is traced
+        /// </summary>
+        using Clock = std::chrono::steady_clock;
+
+        /// <summary>
+        /// The number of records kept when no capacity is given
+        /// </summary>
+        static const size_t DefaultCapacity = 65536;
+
+        EventTrace() = delete;
+
+        /// <summary>
+        /// Starts tracing into a fresh ring buffer, discarding any previous records. Start and
+        /// Clear must not be called concurrently with each other, but events may be recorded
+        /// on other threads meanwhile.
+        /// </summary>
+        /// <param name="capacity"> The number of records the ring buffer holds </param>
+        static void Start(size_t capacity = DefaultCapacity);
+
+        /// <summary>
+        /// Stops tracing. The records are kept until the next Start or Clear.
+        /// </summary>
+        static void Stop();
+
+        /// <summary>
+        /// Stops tracing and retires the ring buffer, freeing it once nothing records into it
+        /// </summary>
+        static void Clear();
+
+        /// <summary>
+        /// Checks if tracing is on. Instrumented code checks this before reading the clock,
+        /// so tracing costs a single load when it is off.
+        /// </summary>
+        /// <returns> True if tracing is on, false otherwise </returns>
+        static bool IsEnabled() { return m_isEnabled.load(std::memory_order_relaxed); }
+
+        /// <summary>
+        /// Records an event being enqueued
+        /// </summary>
+        /// <param name="event"> The event being enqueued </param>
+        /// <param name="delay"> The delay it was enqueued with </param>
+        static void RecordEnqueue(const EventPublisher& event, std::chrono::milliseconds delay);
+
+        /// <summary>
+        /// Records an event being delivered
+        /// </summary>
+        /// <param name="event"> The event delivered </param>
+        /// <param name="subscriberCount"> The number of subscribers notified </param>
+        /// <param name="start"> When the delivery started </param>
+        /// <param name="end"> When the delivery finished </param>
+        static void RecordDeliver(const EventPublisher& event, size_t subscriberCount, Clock::time_point start, Clock::time_point end);
+
+        /// <summary>
+        /// Records one subscriber being notified of an event
+        /// </summary>
+        /// <param name="event"> The event delivered </param>
+        /// <param name="start"> When Notify was called </param>
+        /// <param name="end"> When Notify returned </param>
+        static void RecordNotify(const EventPublisher& event, Clock::time_point start, Clock::time_point end);
+
+        /// <summary>
+        /// Gets the records still in the ring buffer, oldest first. Records that are being
+        /// written at the same time are skipped.
+        /// </summary>
+        /// <returns> A copy of the records </returns>
+        static Vector<EventTraceRecord> Records();
+
+        /// <summary>
+        /// Converts the records into a Chrome trace event document
+        /// </summary>
+        /// <returns> The JSON representation of the trace </returns>
+        static Json::Value ToChromeTrace();
+
+        /// <summary>
+        /// Writes the Chrome trace event document to a file
+        /// </summary>
+        /// <param name="fileName"> The path of the file to write </param>
+        /// <exception cref="std::runtime_error"> Throws if the file can't be opened </exception>
+        static void DumpChromeTraceToFile(const std::string& fileName);
+
+    private:
+        /// <summary>
+        /// One slot of the ring buffer. The sequence is odd while the record is being
+        /// written and even once it is done, so readers can tell a torn record apart.
+        /// </summary>
+        struct Slot
+        {
+            std::atomic<std::uint64_t> m_sequence;
+            EventTraceRecord m_record;
+        };
+
+        /// <summary>
+        /// A ring buffer along with everything needed to write into it, published as one so a
+        /// writer never mixes the state of two buffers
+        /// </summary>
+        struct Buffer final
+        {
+            explicit Buffer(size_t capacity);
+            Buffer(const Buffer&) = delete;
+            Buffer& operator=(const Buffer&) = delete;
+            ~Buffer();
+
+            /// <summary>
+            /// The slots of the ring buffer
+            /// </summary>
+            gsl::owner<Slot*> m_slots;
+
+            /// <summary>
+            /// The number of slots in the ring buffer
+            /// </summary>
+            size_t m_capacity;
+
+            /// <summary>
+            /// The total number of records ever claimed in this buffer
+            /// </summary>
+            std::atomic<std::uint64_t> m_head{ 0 };
+
+            /// <summary>
+            /// When tracing into this buffer started
+            /// </summary>
+            Clock::time_point m_origin;
+        };
+
+        /// <summary>
+        /// A buffer replaced by Start or Clear, with the epoch it was retired in
+        /// </summary>
+        struct RetiredBuffer final
+        {
+            const Buffer* m_buffer;
+            std::uint64_t m_tag;
+        };
+
+        /// <summary>
+        /// Claims the next slot and writes the record into it
+        /// </summary>
+        /// <param name="record"> The record to write </param>
+        /// <param name="time"> When the recorded thing happened </param>
+        static void Write(EventTraceRecord record, Clock::time_point time);
+
+        /// <summary>
+        /// Publishes a new buffer, or none, and retires the previous one
+        /// </summary>
+        /// <param name="buffer"> The buffer to publish, or nullptr </param>
+        static void Replace(gsl::owner<Buffer*> buffer);
+
+        /// <summary>
+        /// Whether tracing is on
+        /// </summary>
+        static std::atomic<bool> m_isEnabled;
+
+        /// <summary>
+        /// The buffer being traced into, or nullptr if there is none. Only read while a
+        /// ReadEpoch::Guard is alive.
+        /// </summary>
+        static std::atomic<Buffer*> m_buffer;
+
+        /// <summary>
+        /// Buffers that may still be in use, oldest first
+        /// </summary>
+        static Vector<RetiredBuffer> m_retired;
+    };
+}
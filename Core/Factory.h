@@ -1,14 +1,23 @@
 #pragma once
 #include "HashMap.h"
+#include "ObjectPool.h"
+#include "ReadEpoch.h"
 #include "RTTI.h"
+#include "Vector.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <gsl/gsl>
+#include <type_traits>
 
 namespace FieaGameEngine
 {
     /// <summary>
     /// Templated abstract Factory class. Serves two purposes: a manager for all other
     /// factories through its static methods and also an abstract base class for all
-    /// factories.
+    /// factories. Registration is serialized by a mutex and lookups read a published
+    /// snapshot, so factories can be found from any thread.
     /// </summary>
     template <typename T>
     class Factory
@@ -29,7 +38,26 @@ namespace FieaGameEngine
         virtual gsl::owner<T*> Create() const = 0;
 
         /// <summary>
-        /// Finds a concrete factory based on the passed in name
+        /// Constructs count instances of this factory's class and appends them to created.
+        /// Pooled factories reserve free slots for the whole batch up front, so the pool grows at
+        /// most once. The pool is shared with every other instance of the class, so slots freed
+        /// earlier are handed out first and the instances aren't guaranteed to be contiguous.
+        /// </summary>
+        /// <param name="count"> The number of instances to construct </param>
+        /// <param name="created"> The Vector to append the new instances to </param>
+        virtual void CreateBatch(size_t count, Vector<gsl::owner<T*>>& created) const;
+
+        /// <summary>
+        /// Gets the statistics of the pool this factory allocates from
+        /// </summary>
+        /// <returns> The pool's statistics, all zeros if this factory isn't pooled </returns>
+        virtual PoolStats PoolStatistics() const;
+
+        /// <summary>
+        /// Finds a concrete factory based on the passed in name. The returned pointer is a
+        /// stable handle: it stays valid for as long as the concrete factory is registered,
+        /// so callers that spawn the same class repeatedly should resolve it once and call
+        /// Create() on it directly instead of going through the name every time.
         /// </summary>
         /// <param name="className"> The name of the class to find the factory for </param>
         /// <returns> A pointer to the found factory, nullptr if the factory couldn't
@@ -45,6 +73,32 @@ namespace FieaGameEngine
         /// concrete factory registered with this factory manager </exception>
         static gsl::owner<T*> Create(const std::string& className);
 
+        /// <summary>
+        /// Creates count instances of a class through a concrete factory based on the name
+        /// passed in
+        /// </summary>
+        /// <param name="className"> The name of the class to construct </param>
+        /// <param name="count"> The number of instances to construct </param>
+        /// <returns> A Vector of the newly heap allocated instances, empty if the class
+        /// name passed in does not have a concrete factory registered </returns>
+        static Vector<gsl::owner<T*>> CreateBatch(const std::string& className, size_t count);
+
+        /// <summary>
+        /// Publishes a frozen snapshot of the registered factories that is indexed by a perfect
+        /// hash, so every later name lookup probes exactly one slot without locking. The hash is
+        /// built by hash and displace: names are split into small buckets, and each bucket gets
+        /// its own displacement that moves all of its names onto free slots. Call this
+        /// once startup registration is done. A factory added or removed later is published as
+        /// a fresh snapshot on the next lookup, leaving the one other threads are reading intact.
+        /// </summary>
+        static void Freeze();
+
+        /// <summary>
+        /// Whether the published snapshot is up to date with every registered factory
+        /// </summary>
+        /// <returns> True if no factory was added or removed since the last publish </returns>
+        static bool IsFrozen();
+
         /// <summary>
         /// Returns the number of registered concrete factories
         /// </summary>
@@ -77,9 +131,116 @@ namespace FieaGameEngine
 
     private:
         /// <summary>
-        /// Internal hashmap to keep track of registered factories
+        /// Immutable snapshot of the registered factories, indexed by a perfect hash. A name's
+        /// bucket picks a displacement, and the displaced hash picks its slot. Every registered
+        /// name lands in a different slot.
+        /// </summary>
+        struct FrozenRegistry final
+        {
+            Vector<const Factory*> m_slots;
+            Vector<std::uint32_t> m_displacements;
+            size_t m_count = 0;
+        };
+
+        /// <summary>
+        /// A snapshot replaced by a later publish, with the epoch it was retired in
+        /// </summary>
+        struct RetiredRegistry final
+        {
+            const FrozenRegistry* m_registry;
+            std::uint64_t m_tag;
+        };
+
+        /// <summary>
+        /// Marks a lookup in flight for as long as it is alive, in the reading thread's own
+        /// epoch record, so PublishLocked knows when no reader can still be holding a retired
+        /// snapshot. Publishes first if the registry is dirty.
+        /// </summary>
+        class ReadGuard final
+        {
+        public:
+            ReadGuard();
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+        private:
+            ReadEpoch::Guard m_epochGuard;
+        };
+
+        /// <summary>
+        /// The number of displacements Freeze tries for one bucket before doubling the table
+        /// </summary>
+        static const std::uint32_t FreezeDisplacementAttempts = 1024;
+
+        /// <summary>
+        /// The average number of names Freeze puts in each bucket
+        /// </summary>
+        static const size_t FreezeBucketLoad = 4;
+
+        /// <summary>
+        /// FNV-1a hash of a name, computed once per lookup
+        /// </summary>
+        /// <param name="className"> The name to hash </param>
+        /// <returns> The hash of the name </returns>
+        static std::uint64_t FrozenHash(const std::string& className);
+
+        /// <summary>
+        /// Gets the bucket a name's hash falls into
+        /// </summary>
+        /// <param name="hash"> The hash of the name </param>
+        /// <param name="bucketCount"> The number of buckets, a power of two </param>
+        /// <returns> The bucket index </returns>
+        static size_t FrozenBucket(std::uint64_t hash, size_t bucketCount);
+
+        /// <summary>
+        /// Gets the slot a name's hash lands on under a displacement
+        /// </summary>
+        /// <param name="hash"> The hash of the name </param>
+        /// <param name="displacement"> The displacement of the name's bucket </param>
+        /// <param name="slotCount"> The number of slots, a power of two </param>
+        /// <returns> The slot index </returns>
+        static size_t FrozenSlot(std::uint64_t hash, std::uint32_t displacement, size_t slotCount);
+
+        /// <summary>
+        /// Gets the published snapshot. Must be called while a ReadGuard is alive.
+        /// </summary>
+        /// <returns> The current snapshot </returns>
+        static const FrozenRegistry& Snapshot();
+
+        /// <summary>
+        /// Builds a snapshot of m_factories and publishes it. The previous snapshot is retired
+        /// rather than deleted, since readers on other threads may still be using it, and each
+        /// retired snapshot is deleted by the first publish after every lookup that could have
+        /// seen it has finished. Must be called with m_mutex held.
+        /// </summary>
+        static void PublishLocked();
+
+        /// <summary>
+        /// Internal hashmap to keep track of registered factories. Only touched with m_mutex
+        /// held; lookups go through the published snapshot instead.
         /// </summary>
         inline static HashMap<std::string, const Factory* const> m_factories;
+
+        /// <summary>
+        /// Serializes registration and publishing
+        /// </summary>
+        inline static std::mutex m_mutex;
+
+        /// <summary>
+        /// Whether a factory was added or removed since the last publish
+        /// </summary>
+        inline static std::atomic<bool> m_isDirty{ false };
+
+        /// <summary>
+        /// The snapshot every lookup reads from without locking, nullptr until the first publish
+        /// </summary>
+        inline static std::atomic<const FrozenRegistry*> m_published{ nullptr };
+
+        /// <summary>
+        /// Snapshots replaced by a later publish, kept alive until no lookup can still hold them.
+        /// Only touched with m_mutex held.
+        /// </summary>
+        inline static Vector<RetiredRegistry> m_retired;
     };
 
     /// <summary>
@@ -95,7 +256,37 @@ namespace FieaGameEngine
         gsl::owner<AbstractT*> Create() const override { return new ConcreteT(); }                      \
     private:                                                                                            \
         inline static const std::string m_classname { #ConcreteT };                                     \
-    };        
+    };
+
+    /// <summary>
+    /// Concrete Factory macro for classes that declare POOL_DECLARATIONS. Instances come out of
+    /// the class's ObjectPool, so creating and destroying them reuses slab memory.
+    /// </summary>
+    #define PooledConcreteFactory(ConcreteT, AbstractT)                                                     \
+    class ConcreteT##Factory final : public FieaGameEngine::Factory<AbstractT>                             \
+    {                                                                                                   \
+        static_assert(std::is_same_v<ConcreteT::PooledType, ConcreteT>, #ConcreteT " must declare POOL_DECLARATIONS to use a pooled factory!"); \
+    public:                                                                                             \
+        ConcreteT##Factory() { Add(*this); }                                                            \
+        ~ConcreteT##Factory() { Remove(*this); }                                                        \
+        const std::string & ClassName() const override { return m_classname; }                          \
+        gsl::owner<AbstractT*> Create() const override { return new ConcreteT(); }                      \
+        void CreateBatch(size_t count, FieaGameEngine::Vector<gsl::owner<AbstractT*>>& created) const override \
+        {                                                                                               \
+            FieaGameEngine::ObjectPool<ConcreteT>::Shared().Reserve(count);                             \
+            created.Reserve(created.Size() + count);                                                    \
+            for (size_t i = 0; i < count; ++i)                                                          \
+            {                                                                                           \
+                created.PushBack(new ConcreteT());                                                      \
+            }                                                                                           \
+        }                                                                                               \
+        FieaGameEngine::PoolStats PoolStatistics() const override                                       \
+        {                                                                                               \
+            return FieaGameEngine::ObjectPool<ConcreteT>::Shared().Stats();                             \
+        }                                                                                               \
+    private:                                                                                            \
+        inline static const std::string m_classname { #ConcreteT };                                     \
+    };
 
 }
 
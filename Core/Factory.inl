@@ -6,20 +6,46 @@ namespace FieaGameEngine
     template<typename T>
     inline gsl::owner<T*> Factory<T>::Create(const std::string& className)
     {
-        auto it = m_factories.Find(className);
+        const Factory* factory = Find(className);
 
-        if (it == m_factories.end())
+        return (factory == nullptr) ? nullptr : factory->Create();
+    }
+
+    template<typename T>
+    inline Vector<gsl::owner<T*>> Factory<T>::CreateBatch(const std::string& className, size_t count)
+    {
+        Vector<gsl::owner<T*>> created;
+
+        const Factory* factory = Find(className);
+        if (factory != nullptr && count > 0)
         {
-            return nullptr;
+            factory->CreateBatch(count, created);
+        }
+
+        return created;
+    }
+
+    template<typename T>
+    inline void Factory<T>::CreateBatch(size_t count, Vector<gsl::owner<T*>>& created) const
+    {
+        created.Reserve(created.Size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            created.PushBack(Create());
         }
+    }
 
-        return it->second->Create();
+    template<typename T>
+    inline PoolStats Factory<T>::PoolStatistics() const
+    {
+        return PoolStats();
     }
 
     template<typename T>
     inline size_t Factory<T>::Size()
     {
-        return m_factories.Size();
+        ReadGuard guard;
+        return Snapshot().m_count;
     }
 
     template<typename T>
@@ -31,27 +57,255 @@ namespace FieaGameEngine
     template<typename T>
     inline const Factory<T>* const Factory<T>::Find(const std::string& className)
     {
-        auto it = m_factories.Find(className);
+        ReadGuard guard;
+        const FrozenRegistry& registry = Snapshot();
+        if (registry.m_slots.IsEmpty())
+        {
+            return nullptr;
+        }
+
+        std::uint64_t hash = FrozenHash(className);
+        std::uint32_t displacement = registry.m_displacements[FrozenBucket(hash, registry.m_displacements.Size())];
+        if (displacement == 0)
+        {
+            // No registered name falls in this bucket
+            return nullptr;
+        }
 
-        return (it == m_factories.end()) ? nullptr : it->second;
+        const Factory* factory = registry.m_slots[FrozenSlot(hash, displacement, registry.m_slots.Size())];
+
+        // Names that aren't registered can still land on an occupied slot
+        return (factory != nullptr && factory->ClassName() == className) ? factory : nullptr;
+    }
+
+    template<typename T>
+    inline void Factory<T>::Freeze()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PublishLocked();
+    }
+
+    template<typename T>
+    inline bool Factory<T>::IsFrozen()
+    {
+        return (!m_isDirty.load(std::memory_order_acquire) && m_published.load(std::memory_order_acquire) != nullptr);
+    }
+
+    template<typename T>
+    inline Factory<T>::ReadGuard::ReadGuard()
+    {
+        if (m_isDirty.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Another reader may have published while we waited for the lock
+            if (m_isDirty.load(std::memory_order_relaxed))
+            {
+                PublishLocked();
+            }
+        }
+    }
+
+    template<typename T>
+    inline std::uint64_t Factory<T>::FrozenHash(const std::string& className)
+    {
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (char character : className)
+        {
+            hash ^= static_cast<std::uint8_t>(character);
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    template<typename T>
+    inline size_t Factory<T>::FrozenBucket(std::uint64_t hash, size_t bucketCount)
+    {
+        // FNV-1a leaves similar names close together, so mix before taking the bucket
+        std::uint64_t mixed = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+        mixed ^= (mixed >> 33);
+
+        return static_cast<size_t>(mixed >> 32) & (bucketCount - 1);
+    }
+
+    template<typename T>
+    inline size_t Factory<T>::FrozenSlot(std::uint64_t hash, std::uint32_t displacement, size_t slotCount)
+    {
+        // SplitMix64 finalizer, so each displacement scatters the bucket's names independently
+        std::uint64_t mixed = hash + displacement * 0x9E3779B97F4A7C15ULL;
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+        mixed ^= (mixed >> 31);
+
+        return static_cast<size_t>(mixed) & (slotCount - 1);
+    }
+
+    template<typename T>
+    inline const typename Factory<T>::FrozenRegistry& Factory<T>::Snapshot()
+    {
+        const FrozenRegistry* registry = m_published.load();
+        if (registry == nullptr)
+        {
+            static const FrozenRegistry emptyRegistry;
+            return emptyRegistry;
+        }
+
+        return *registry;
+    }
+
+    template<typename T>
+    inline void Factory<T>::PublishLocked()
+    {
+        struct Entry
+        {
+            std::uint64_t m_hash;
+            size_t m_bucket;
+            const Factory* m_factory;
+        };
+
+        const size_t count = m_factories.Size();
+
+        size_t bucketCount = 1;
+        while (bucketCount * FreezeBucketLoad < count)
+        {
+            bucketCount *= 2;
+        }
+
+        size_t slotCount = 8;
+        while (slotCount < count * 2)
+        {
+            slotCount *= 2;
+        }
+
+        // Hash every name once and count how full each bucket is
+        Vector<Entry> entries;
+        entries.Reserve(count);
+        Vector<size_t> bucketSizes;
+        bucketSizes.Resize(bucketCount);
+        for (const auto& [className, factory] : m_factories)
+        {
+            std::uint64_t hash = FrozenHash(className);
+            size_t bucket = FrozenBucket(hash, bucketCount);
+            entries.PushBack({ hash, bucket, factory });
+            ++bucketSizes[bucket];
+        }
+
+        // Place the fullest buckets first, while the table is still mostly empty
+        if (!entries.IsEmpty())
+        {
+            Entry* first = &entries.Front();
+            std::stable_sort(first, first + entries.Size(), [&bucketSizes](const Entry& lhs, const Entry& rhs)
+                {
+                    if (bucketSizes[lhs.m_bucket] != bucketSizes[rhs.m_bucket])
+                    {
+                        return bucketSizes[lhs.m_bucket] > bucketSizes[rhs.m_bucket];
+                    }
+
+                    return lhs.m_bucket < rhs.m_bucket;
+                });
+        }
+
+        FrozenRegistry* registry = new FrozenRegistry();
+        registry->m_count = count;
+
+        // A bucket that finds no displacement in time doubles the table, which guarantees progress
+        for (bool isPerfect = false; !isPerfect; )
+        {
+            registry->m_slots.Clear();
+            registry->m_slots.Resize(slotCount);
+            registry->m_displacements.Clear();
+            registry->m_displacements.Resize(bucketCount);
+
+            isPerfect = true;
+            for (size_t begin = 0; begin < entries.Size() && isPerfect; begin += bucketSizes[entries[begin].m_bucket])
+            {
+                size_t end = begin + bucketSizes[entries[begin].m_bucket];
+
+                std::uint32_t displacement = 1;
+                for (; displacement <= FreezeDisplacementAttempts; ++displacement)
+                {
+                    size_t placed = begin;
+                    for (; placed < end; ++placed)
+                    {
+                        const Factory*& slot = registry->m_slots[FrozenSlot(entries[placed].m_hash, displacement, slotCount)];
+                        if (slot != nullptr)
+                        {
+                            break;
+                        }
+
+                        slot = entries[placed].m_factory;
+                    }
+
+                    if (placed == end)
+                    {
+                        break;
+                    }
+
+                    // Take back the names this displacement already placed
+                    for (size_t i = begin; i < placed; ++i)
+                    {
+                        registry->m_slots[FrozenSlot(entries[i].m_hash, displacement, slotCount)] = nullptr;
+                    }
+                }
+
+                if (displacement > FreezeDisplacementAttempts)
+                {
+                    isPerfect = false;
+                    slotCount *= 2;
+                }
+                else
+                {
+                    registry->m_displacements[entries[begin].m_bucket] = displacement;
+                }
+            }
+        }
+
+        const FrozenRegistry* previous = m_published.exchange(registry);
+        if (previous != nullptr)
+        {
+            m_retired.PushBack({ previous, ReadEpoch::Retire() });
+        }
+
+        // Snapshots are retired in order, so the reclaimable ones are at the front
+        size_t reclaimed = 0;
+        while (reclaimed < m_retired.Size() && ReadEpoch::IsReclaimable(m_retired[reclaimed].m_tag))
+        {
+            delete m_retired[reclaimed].m_registry;
+            ++reclaimed;
+        }
+
+        if (reclaimed > 0)
+        {
+            m_retired.Remove(m_retired.begin(), m_retired.begin() + reclaimed);
+        }
+
+        m_isDirty.store(false, std::memory_order_release);
     }
 
     template<typename T>
     inline void Factory<T>::Add(const Factory& factory)
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
         auto [it, wasInserted] = m_factories.Insert(std::make_pair(factory.ClassName(), &factory));
 
         if (!wasInserted)
         {
             throw std::exception("Trying to add a factory whose name already exists!");
         }
+
+        m_isDirty.store(true, std::memory_order_release);
     }
 
     template<typename T>
     inline void Factory<T>::Remove(const Factory& factory)
     {
-        m_factories.Remove(factory.ClassName());
-    }
-
+        std::lock_guard<std::mutex> lock(m_mutex);
 
-}
\ No newline at end of file
+        if (m_factories.Remove(factory.ClassName()))
+        {
+            m_isDirty.store(true, std::memory_order_release);
+        }
+    }
+}
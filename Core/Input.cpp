@@ -4,15 +4,25 @@
 namespace FieaGameEngine
 {
     RTTI_DEFINITIONS(KeyboardEvent);
+    RTTI_DEFINITIONS(InputFrame);
 
     void InputManager::Update()
     {
-        for (int heldKey : m_heldKeys)
+        // Commit everything injected since the last frame, then tell everyone about it at once
+        m_previousState = m_currentState;
+        m_currentState = m_pendingState;
+
+        std::swap(m_frameTransitions, m_transitions);
+        m_transitions.Clear();
+
+        if (m_frameTransitions.IsEmpty() && m_currentState.none())
         {
-            KeyboardEvent keyboardEvent{ heldKey, KEY_REPEAT };
-            Event<KeyboardEvent> event(keyboardEvent);
-            event.Deliver();
+            return;
         }
+
+        InputFrame inputFrame{ m_frameTransitions, m_currentState, m_previousState };
+        Event<InputFrame> event(inputFrame);
+        event.Deliver();
     }
 
     void InputManager::Inititalize(GLFWwindow* window)
@@ -23,39 +33,41 @@ namespace FieaGameEngine
 
     void InputManager::KeyboardEventCallback(GLFWwindow* /*window*/, int key, int /*scancode*/, int action, int /*mods*/)
     {
-
-        if (action == GLFW_PRESS)
-        {
-            m_heldKeys.PushBack(key);
-        }
-        else if (action == GLFW_RELEASE)
-        {
-            m_heldKeys.Remove(key);
-        }
-
-        // create event based on key (and action?)
-        KeyboardEvent keyboardEvent{ key, action };
-        Event<KeyboardEvent> event(keyboardEvent);
-        event.Deliver();
+        InjectKey(key, action);
     }
 
     void InputManager::MouseButtonCallback(GLFWwindow*, int button, int action, int)
     {
-        if (action == GLFW_PRESS)
-        {
-            m_heldKeys.PushBack(button);
-        }
-        else if (action == GLFW_RELEASE)
+        InjectKey(button, action);
+    }
+
+    void InputManager::InjectKey(int key, int action)
+    {
+        if (!IsValidKey(key) || (action != GLFW_PRESS && action != GLFW_RELEASE))
         {
-            m_heldKeys.Remove(button);
+            return;
         }
 
-        // create event based on key (and action?)
-        KeyboardEvent keyboardEvent{ button, action };
-        Event<KeyboardEvent> event(keyboardEvent);
-        event.Deliver();
+        m_pendingState.set(static_cast<size_t>(key), action == GLFW_PRESS);
+        m_transitions.PushBack(KeyboardEvent{ key, action });
     }
 
+    bool InputManager::IsKeyDown(int key)
+    {
+        return IsValidKey(key) && m_currentState.test(static_cast<size_t>(key));
+    }
 
+    bool InputManager::WasKeyDown(int key)
+    {
+        return IsValidKey(key) && m_previousState.test(static_cast<size_t>(key));
+    }
 
-}
\ No newline at end of file
+    void InputManager::Reset()
+    {
+        m_pendingState.reset();
+        m_currentState.reset();
+        m_previousState.reset();
+        m_transitions.Clear();
+        m_frameTransitions.Clear();
+    }
+}
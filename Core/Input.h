@@ -3,6 +3,7 @@
 #include "Vector.h"
 #include "HashMap.h"
 #include "RTTI.h"
+#include <bitset>
 
 namespace FieaGameEngine
 {
@@ -32,11 +33,64 @@ namespace FieaGameEngine
 		{
 			return (key == other.key) && (action == other.action);
 		}
+
+		/// <summary>
+		/// Fills in the key that identifies redundant keyboard events, which are the same action
+		/// on the same key
+		/// </summary>
+		/// <param name="coalescingKey"> The key to fill in </param>
+		/// <returns> Always true, every keyboard event can be coalesced </returns>
+		bool CoalescingKey(EventCoalescingKey& coalescingKey) const
+		{
+			coalescingKey.m_subtype.clear();
+			coalescingKey.m_target = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key)) << 32) | static_cast<std::uint32_t>(action);
+			return true;
+		}
+	};
+
+	/// <summary>
+	/// Every key and mouse button indexed by its GLFW code. Mouse buttons share the low
+	/// indices, below the first GLFW key code.
+	/// </summary>
+	using KeyState = std::bitset<GLFW_KEY_LAST + 1>;
+
+	/// <summary>
+	/// Batched input payload delivered once per frame, carrying every press and release
+	/// since the last frame along with the keys held now and during the last frame
+	/// </summary>
+	struct InputFrame : public RTTI
+	{
+		RTTI_DECLARATIONS(InputFrame, RTTI);
+
+	public:
+		/// <summary>
+		/// Every press and release since the last frame, in the order they happened
+		/// </summary>
+		const Vector<KeyboardEvent>* m_transitions;
+
+		/// <summary>
+		/// The keys held this frame
+		/// </summary>
+		const KeyState* m_currentState;
+
+		/// <summary>
+		/// The keys held last frame
+		/// </summary>
+		const KeyState* m_previousState;
+
+		InputFrame(const Vector<KeyboardEvent>& transitions, const KeyState& currentState, const KeyState& previousState)
+			: m_transitions(&transitions), m_currentState(&currentState), m_previousState(&previousState)
+		{}
 	};
 
 	class InputManager
 	{
 	public:
+		/// <summary>
+		/// Commits the input gathered since the last call as this frame's state and delivers a
+		/// single InputFrame event if anything is pressed or changed. Call this once per
+		/// frame, after polling for window events.
+		/// </summary>
 		static void Update();
 
 		static void Inititalize(GLFWwindow* window);
@@ -44,9 +98,79 @@ namespace FieaGameEngine
 		static void KeyboardEventCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 		static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
 
+		/// <summary>
+		/// Feeds a key or mouse button action in as if it came from GLFW, so input can be driven
+		/// without a window. OS key repeats are ignored, since held keys are tracked per frame.
+		/// </summary>
+		/// <param name="key"> The GLFW key or mouse button code </param>
+		/// <param name="action"> GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT </param>
+		static void InjectKey(int key, int action);
+
+		/// <summary>
+		/// Checks if a key is held this frame
+		/// </summary>
+		/// <param name="key"> The GLFW key or mouse button code </param>
+		/// <returns> True if the key is held, false otherwise </returns>
+		static bool IsKeyDown(int key);
+
+		/// <summary>
+		/// Checks if a key was held last frame
+		/// </summary>
+		/// <param name="key"> The GLFW key or mouse button code </param>
+		/// <returns> True if the key was held, false otherwise </returns>
+		static bool WasKeyDown(int key);
+
+		/// <summary>
+		/// Checks if a key went down this frame
+		/// </summary>
+		/// <param name="key"> The GLFW key or mouse button code </param>
+		/// <returns> True if the key is held now but wasn't last frame </returns>
+		static bool IsKeyPressed(int key) { return IsKeyDown(key) && !WasKeyDown(key); }
+
+		/// <summary>
+		/// Checks if a key went up this frame
+		/// </summary>
+		/// <param name="key"> The GLFW key or mouse button code </param>
+		/// <returns> True if the key was held last frame but isn't now </returns>
+		static bool IsKeyReleased(int key) { return !IsKeyDown(key) && WasKeyDown(key); }
+
+		/// <summary>
+		/// Forgets every held key and pending transition
+		/// </summary>
+		static void Reset();
+
 	private:
-		inline static Vector<int> m_heldKeys;
+		/// <summary>
+		/// Checks if a code fits in the key state table
+		/// </summary>
+		/// <param name="key"> The code to check </param>
+		/// <returns> True if the code is in range, false otherwise </returns>
+		static bool IsValidKey(int key) { return key >= 0 && key <= GLFW_KEY_LAST; }
+
+		/// <summary>
+		/// Key state as of the latest injected action, ahead of the frame state
+		/// </summary>
+		inline static KeyState m_pendingState;
+
+		/// <summary>
+		/// Key state committed by the last Update
+		/// </summary>
+		inline static KeyState m_currentState;
+
+		/// <summary>
+		/// Key state committed by the Update before that
+		/// </summary>
+		inline static KeyState m_previousState;
+
+		/// <summary>
+		/// Presses and releases since the last Update. Cleared, not freed, so its memory is reused.
+		/// </summary>
+		inline static Vector<KeyboardEvent> m_transitions;
 
+		/// <summary>
+		/// Presses and releases delivered by the last Update
+		/// </summary>
+		inline static Vector<KeyboardEvent> m_frameTransitions;
 	};
 
 }
@@ -0,0 +1,112 @@
+#include "pch.h"
+#include "MemoryUsage.h"
+#include <fstream>
+
+namespace FieaGameEngine
+{
+    namespace
+    {
+        const char* const DatumTypeNames[MemoryBreakdown::DatumTypeCount] =
+        {
+            "Integer",
+            "String",
+            "Float",
+            "Vector",
+            "Matrix",
+            "RTTI",
+            "Table"
+        };
+
+        Json::Value::UInt64 ToJsonSize(size_t value)
+        {
+            return static_cast<Json::Value::UInt64>(value);
+        }
+    }
+
+    MemoryBreakdown& MemoryBreakdown::operator+=(const MemoryBreakdown& other)
+    {
+        m_scopeCount += other.m_scopeCount;
+        m_scopeHeaderBytes += other.m_scopeHeaderBytes;
+        m_indexBucketBytes += other.m_indexBucketBytes;
+        m_orderBytes += other.m_orderBytes;
+        m_datumHeaderBytes += other.m_datumHeaderBytes;
+        m_keyStringHeapBytes += other.m_keyStringHeapBytes;
+        m_externalPayloadBytes += other.m_externalPayloadBytes;
+        m_stringHeapBytes += other.m_stringHeapBytes;
+
+        for (size_t i = 0; i < DatumTypeCount; ++i)
+        {
+            m_payloadBytes[i] += other.m_payloadBytes[i];
+        }
+
+        return *this;
+    }
+
+    size_t MemoryBreakdown::TotalBytes() const
+    {
+        size_t total = m_scopeHeaderBytes + m_indexBucketBytes + m_orderBytes + m_keyStringHeapBytes + m_stringHeapBytes;
+
+        for (size_t i = 0; i < DatumTypeCount; ++i)
+        {
+            total += m_payloadBytes[i];
+        }
+
+        return total;
+    }
+
+    Json::Value MemoryBreakdown::ToJson() const
+    {
+        Json::Value root(Json::objectValue);
+        root["ScopeCount"] = ToJsonSize(m_scopeCount);
+        root["ScopeHeaderBytes"] = ToJsonSize(m_scopeHeaderBytes);
+        root["IndexBucketBytes"] = ToJsonSize(m_indexBucketBytes);
+        root["OrderBytes"] = ToJsonSize(m_orderBytes);
+        root["DatumHeaderBytes"] = ToJsonSize(m_datumHeaderBytes);
+        root["KeyStringHeapBytes"] = ToJsonSize(m_keyStringHeapBytes);
+        root["ExternalPayloadBytes"] = ToJsonSize(m_externalPayloadBytes);
+        root["StringHeapBytes"] = ToJsonSize(m_stringHeapBytes);
+        root["TotalBytes"] = ToJsonSize(TotalBytes());
+
+        Json::Value payload(Json::objectValue);
+        for (size_t i = 0; i < DatumTypeCount; ++i)
+        {
+            payload[DatumTypeNames[i]] = ToJsonSize(m_payloadBytes[i]);
+        }
+        root["PayloadBytes"] = payload;
+
+        return root;
+    }
+
+    Json::Value ScopeMemoryUsage::ToJson() const
+    {
+        Json::Value root(Json::objectValue);
+        root["Total"] = m_total.ToJson();
+
+        Json::Value byType(Json::objectValue);
+        for (const auto& [typeName, breakdown] : m_byType)
+        {
+            byType[typeName] = breakdown.ToJson();
+        }
+        root["ByType"] = byType;
+
+        return root;
+    }
+
+    std::string ScopeMemoryUsage::Dump() const
+    {
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = "    ";
+        return Json::writeString(builder, ToJson());
+    }
+
+    void ScopeMemoryUsage::DumpToFile(const std::string& fileName) const
+    {
+        std::ofstream file(fileName);
+        if (!file.is_open())
+        {
+            throw std::exception("Could not open the file to dump memory usage into!");
+        }
+
+        file << Dump();
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <map>
+#include <string>
+#include <json/json.h>
+#include "Datum.h"
+
+namespace FieaGameEngine
+{
+    /// <summary>
+    /// Byte breakdown of the memory used by one or more Scopes. Every field is a sum, so
+    /// breakdowns of individual Scopes can be added together.
+    /// </summary>
+    struct MemoryBreakdown final
+    {
+        /// <summary>
+        /// The number of DatumTypes that have their payload tracked separately (Unknown excluded)
+        /// </summary>
+        static const size_t DatumTypeCount = static_cast<size_t>(Datum::DatumType::Unknown);
+
+        /// <summary>
+        /// How many Scopes contributed to this breakdown
+        /// </summary>
+        size_t m_scopeCount = 0;
+
+        /// <summary>
+        /// Bytes of the Scope objects themselves, at the size of each node's most derived type
+        /// </summary>
+        size_t m_scopeHeaderBytes = 0;
+
+        /// <summary>
+        /// Bytes allocated for the hash index buckets
+        /// </summary>
+        size_t m_indexBucketBytes = 0;
+
+        /// <summary>
+        /// Bytes allocated for the contiguous pair storage (m_order), used or not
+        /// </summary>
+        size_t m_orderBytes = 0;
+
+        /// <summary>
+        /// Bytes of the Datum headers of every stored pair. These live inside m_orderBytes.
+        /// </summary>
+        size_t m_datumHeaderBytes = 0;
+
+        /// <summary>
+        /// Heap bytes owned by key strings that don't fit in the small string buffer
+        /// </summary>
+        size_t m_keyStringHeapBytes = 0;
+
+        /// <summary>
+        /// Bytes of internally owned Datum payload, indexed by DatumType
+        /// </summary>
+        size_t m_payloadBytes[DatumTypeCount] = {};
+
+        /// <summary>
+        /// Bytes of Datum payload that lives in external storage (inside the owning object)
+        /// </summary>
+        size_t m_externalPayloadBytes = 0;
+
+        /// <summary>
+        /// Heap bytes owned by string values stored in String Datums
+        /// </summary>
+        size_t m_stringHeapBytes = 0;
+
+        /// <summary>
+        /// Adds the other breakdown into this one
+        /// </summary>
+        /// <param name="other"> The breakdown to add </param>
+        /// <returns> A reference to this breakdown </returns>
+        MemoryBreakdown& operator+=(const MemoryBreakdown& other);
+
+        /// <summary>
+        /// Sums every byte owned by the Scopes in this breakdown. External payload is excluded
+        /// since it belongs to the owning object, as are Datum headers since they are part
+        /// of the pair storage.
+        /// </summary>
+        /// <returns> The total number of owned bytes </returns>
+        size_t TotalBytes() const;
+
+        /// <summary>
+        /// Converts this breakdown into a JSON object
+        /// </summary>
+        /// <returns> A JSON object with one member per field </returns>
+        Json::Value ToJson() const;
+    };
+
+    /// <summary>
+    /// Result of Scope::MemoryUsage. Holds the recursive total of a Scope tree as well as
+    /// the same data grouped by the RTTI type name of each node.
+    /// </summary>
+    struct ScopeMemoryUsage final
+    {
+        /// <summary>
+        /// The breakdown of every Scope in the tree
+        /// </summary>
+        MemoryBreakdown m_total;
+
+        /// <summary>
+        /// The breakdown of every Scope in the tree grouped by type name. Sorted by name so
+        /// that dumps of two builds can be diffed directly.
+        /// </summary>
+        std::map<std::string, MemoryBreakdown> m_byType;
+
+        /// <summary>
+        /// Converts this usage into a JSON object with a "Total" and a "ByType" member
+        /// </summary>
+        /// <returns> The JSON representation of this usage </returns>
+        Json::Value ToJson() const;
+
+        /// <summary>
+        /// Converts this usage into styled JSON text
+        /// </summary>
+        /// <returns> The JSON text </returns>
+        std::string Dump() const;
+
+        /// <summary>
+        /// Writes the styled JSON text of this usage into the given file
+        /// </summary>
+        /// <param name="fileName"> The file to write to </param>
+        /// <exception cref="std::exception"> Throws if the file couldn't be opened </exception>
+        void DumpToFile(const std::string& fileName) const;
+    };
+}
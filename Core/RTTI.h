@@ -1,7 +1,12 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <cstddef>
+#include <exception>
+#include <mutex>
+#include "HashMap.h"
 
 namespace FieaGameEngine
 {
@@ -11,10 +16,141 @@ namespace FieaGameEngine
 		using IdType = std::size_t;
 		static IdType TypeIdClass() { return 0; }
 
+		/// <summary>
+		/// Precomputed ancestry of a type. Every type knows its depth below RTTI and the ID of
+		/// each of its ancestors indexed by depth, so checking whether it derives from a type of
+		/// known depth is a single compare instead of a virtual walk up the hierarchy. The ID of
+		/// a type is the address of its record, so the depth of any type can be read from its ID.
+		/// </summary>
+		struct TypeRecord final
+		{
+			/// <summary>
+			/// The deepest hierarchy supported below RTTI
+			/// </summary>
+			static const std::size_t MaxDepth = 16;
+
+			/// <summary>
+			/// Constructs the record of RTTI itself, the root of every hierarchy
+			/// </summary>
+			TypeRecord() = default;
+
+			/// <summary>
+			/// Constructs the record of a type from the record of its parent, and interns its name
+			/// </summary>
+			/// <param name="name"> The name of the type. Must outlive the record. </param>
+			/// <param name="parent"> The record of the parent type </param>
+			/// <exception cref="std::exception"> Throws if the hierarchy is deeper than MaxDepth </exception>
+			TypeRecord(std::string_view name, const TypeRecord& parent)
+				: m_id(reinterpret_cast<IdType>(this)), m_name(name), m_depth(parent.m_depth + 1), m_ancestorIds(parent.m_ancestorIds)
+			{
+				if (m_depth >= MaxDepth)
+				{
+					throw std::exception("Type hierarchy is deeper than RTTI supports!");
+				}
+
+				m_ancestorIds[m_depth] = m_id;
+
+				std::lock_guard<std::mutex> lock(NamesMutex());
+				Names().Insert(std::make_pair(std::string(name), m_id));
+			}
+
+			/// <summary>
+			/// Checks whether this type is, or derives from, the type of the other record
+			/// </summary>
+			/// <param name="other"> The record of the type to check against </param>
+			/// <returns> True if this type is the other type or one of its descendants </returns>
+			bool IsA(const TypeRecord& other) const
+			{
+				return (other.m_depth > 0 && other.m_depth <= m_depth && m_ancestorIds[other.m_depth] == other.m_id);
+			}
+
+			/// <summary>
+			/// Checks whether this type is, or derives from, the type with the given ID
+			/// </summary>
+			/// <param name="id"> The ID of the type to check against. Must come from TypeIdClass. </param>
+			/// <returns> True if this type is the given type or one of its descendants </returns>
+			bool IsA(IdType id) const
+			{
+				return (id != 0 && IsA(*reinterpret_cast<const TypeRecord*>(id)));
+			}
+
+			/// <summary>
+			/// Checks whether this type is, or derives from, the type with the given name
+			/// </summary>
+			/// <param name="name"> The name of the type to check against </param>
+			/// <returns> True if this type is the named type or one of its descendants </returns>
+			bool IsA(const std::string& name) const
+			{
+				return IsA(FindId(name));
+			}
+
+			/// <summary>
+			/// Looks up the ID interned for a type name
+			/// </summary>
+			/// <param name="name"> The name of the type </param>
+			/// <returns> The ID of the named type, or 0 if no type by that name has been created </returns>
+			static IdType FindId(const std::string& name)
+			{
+				std::lock_guard<std::mutex> lock(NamesMutex());
+				auto it = Names().Find(name);
+				return (it != Names().end() ? it->second : 0);
+			}
+
+			/// <summary>
+			/// The ID of the type
+			/// </summary>
+			IdType m_id = 0;
+
+			/// <summary>
+			/// The name of the type
+			/// </summary>
+			std::string_view m_name = "RTTI";
+
+			/// <summary>
+			/// How many levels below RTTI the type is
+			/// </summary>
+			std::size_t m_depth = 0;
+
+			/// <summary>
+			/// The ID of the ancestor at each depth, up to and including the type itself
+			/// </summary>
+			std::array<IdType, MaxDepth> m_ancestorIds{};
+
+		private:
+			/// <summary>
+			/// The ID of every type, keyed by name
+			/// </summary>
+			static HashMap<std::string, IdType>& Names()
+			{
+				static HashMap<std::string, IdType> sNames(61);
+				return sNames;
+			}
+
+			/// <summary>
+			/// Guards Names, since records of template types are built lazily on any thread
+			/// </summary>
+			static std::mutex& NamesMutex()
+			{
+				static std::mutex sMutex;
+				return sMutex;
+			}
+		};
+
+		static const TypeRecord& TypeRecordClass()
+		{
+			static const TypeRecord sRecord;
+			return sRecord;
+		}
+
 		virtual ~RTTI() = default;
 
 		virtual FieaGameEngine::RTTI::IdType TypeIdInstance() const = 0;
 
+		virtual const TypeRecord& TypeRecordInstance() const
+		{
+			return TypeRecordClass();
+		}
+
 		virtual RTTI* QueryInterface(const IdType)
 		{
 			return nullptr;
@@ -30,16 +166,32 @@ namespace FieaGameEngine
 			return false;
 		}
 
+		template <typename T>
+		bool Is() const
+		{
+			return TypeRecordInstance().IsA(T::TypeRecordClass());
+		}
+
 		template <typename T>
 		const T* As() const
 		{
-			return (Is(T::TypeIdClass()) ? reinterpret_cast<const T*>(this) : nullptr);
+			return (Is<T>() ? reinterpret_cast<const T*>(this) : nullptr);
 		}
 
 		template <typename T>
 		T* As()
 		{
-			return (Is(T::TypeIdClass()) ? reinterpret_cast<T*>(const_cast<RTTI*>(this)) : nullptr);
+			return (Is<T>() ? reinterpret_cast<T*>(const_cast<RTTI*>(this)) : nullptr);
+		}
+
+		virtual std::string TypeNameInstance() const
+		{
+			return "RTTI";
+		}
+
+		virtual std::size_t InstanceSize() const
+		{
+			return sizeof(RTTI);
 		}
 
 		virtual std::string ToString() const
@@ -55,23 +207,33 @@ namespace FieaGameEngine
 
 #define RTTI_DECLARATIONS(Type, ParentType)																						\
 		public:																													\
+			using FieaGameEngine::RTTI::Is;																						\
 			static std::string TypeName() { return std::string(#Type); }														\
-			static FieaGameEngine::RTTI::IdType TypeIdClass() { return sRunTimeTypeId; }																\
+			static FieaGameEngine::RTTI::IdType TypeIdClass() { return TypeRecordClass().m_id; }													\
 			FieaGameEngine::RTTI::IdType TypeIdInstance() const override { return TypeIdClass(); }											\
+			static const FieaGameEngine::RTTI::TypeRecord& TypeRecordClass()																	\
+			{																													\
+				static const FieaGameEngine::RTTI::TypeRecord sRecord(#Type, ParentType::TypeRecordClass());						\
+				return sRecord;																									\
+			}																													\
+			const FieaGameEngine::RTTI::TypeRecord& TypeRecordInstance() const override { return TypeRecordClass(); }							\
+			std::string TypeNameInstance() const override { return TypeName(); }												\
+			std::size_t InstanceSize() const override { return sizeof(Type); }												\
 			FieaGameEngine::RTTI* QueryInterface(const RTTI::IdType id) override												\
             {																													\
-				return (id == sRunTimeTypeId ? reinterpret_cast<FieaGameEngine::RTTI*>(this) : ParentType::QueryInterface(id)); \
+				return (id == TypeIdClass() ? reinterpret_cast<FieaGameEngine::RTTI*>(this) : ParentType::QueryInterface(id)); \
             }																													\
 			bool Is(FieaGameEngine::RTTI::IdType id) const override																			\
 			{																													\
-				return (id == sRunTimeTypeId ? true : ParentType::Is(id));														\
+				return TypeRecordClass().IsA(id);																				\
 			}																													\
 			bool Is(const std::string& name) const override																\
 			{																													\
-				return (name == TypeName() ? true : ParentType::Is(name));														\
+				return TypeRecordClass().IsA(name);																				\
 			}																													\
 			private:																											\
 				static const FieaGameEngine::RTTI::IdType sRunTimeTypeId;
 
-#define RTTI_DEFINITIONS(Type) const FieaGameEngine::RTTI::IdType Type::sRunTimeTypeId = reinterpret_cast<FieaGameEngine::RTTI::IdType>(&Type::sRunTimeTypeId);
+// Builds the record during static initialization, so the name is interned before any thread runs
+#define RTTI_DEFINITIONS(Type) const FieaGameEngine::RTTI::IdType Type::sRunTimeTypeId = Type::TypeIdClass();
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "pch.h"
+#include "ReadEpoch.h"
+
+namespace FieaGameEngine
+{
+    ReadEpoch::Guard::Guard()
+    {
+        if (m_depth++ == 0)
+        {
+            // Published before the reader loads any snapshot, so a writer that misses it
+            // retired its snapshot before this thread could have seen it
+            ThreadRecord().m_epoch.store(m_epoch.load());
+        }
+    }
+
+    ReadEpoch::Guard::~Guard()
+    {
+        if (--m_depth == 0)
+        {
+            ThreadRecord().m_epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    std::uint64_t ReadEpoch::Retire()
+    {
+        return m_epoch.fetch_add(1) + 1;
+    }
+
+    bool ReadEpoch::IsReclaimable(std::uint64_t tag)
+    {
+        for (Record* record = m_records.load(); record != nullptr; record = record->m_next)
+        {
+            std::uint64_t epoch = record->m_epoch.load();
+            if (epoch != 0 && epoch < tag)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    ReadEpoch::Record& ReadEpoch::ThreadRecord()
+    {
+        // Hands the record back when the thread exits
+        struct Owner final
+        {
+            Record& m_record = ClaimRecord();
+
+            ~Owner()
+            {
+                m_record.m_epoch.store(0, std::memory_order_release);
+                m_record.m_isInUse.store(false, std::memory_order_release);
+            }
+        };
+
+        thread_local Owner owner;
+        return owner.m_record;
+    }
+
+    ReadEpoch::Record& ReadEpoch::ClaimRecord()
+    {
+        for (Record* record = m_records.load(); record != nullptr; record = record->m_next)
+        {
+            bool isInUse = false;
+            if (!record->m_isInUse.load(std::memory_order_relaxed) && record->m_isInUse.compare_exchange_strong(isInUse, true))
+            {
+                return *record;
+            }
+        }
+
+        Record* record = new Record();
+        record->m_isInUse.store(true, std::memory_order_relaxed);
+
+        Record* head = m_records.load();
+        do
+        {
+            record->m_next = head;
+        } while (!m_records.compare_exchange_weak(head, record));
+
+        return *record;
+    }
+}
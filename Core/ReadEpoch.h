@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace FieaGameEngine
+{
+    /// <summary>
+    /// Epoch based reclamation for read-mostly structures that publish immutable snapshots.
+    /// Readers mark themselves with the global epoch in a record of their own thread, padded
+    /// to its own cache line, so reading never writes memory another thread touches. A writer
+    /// that replaces a snapshot tags the old one with Retire and deletes it once IsReclaimable
+    /// says no reader can still be holding it.
+    /// </summary>
+    class ReadEpoch final
+    {
+    public:
+        /// <summary>
+        /// Marks the calling thread as reading for as long as it is alive. Guards nest, and
+        /// only the outermost one on a thread touches its record.
+        /// </summary>
+        class Guard final
+        {
+        public:
+            Guard();
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+            ~Guard();
+        };
+
+        ReadEpoch() = delete;
+
+        /// <summary>
+        /// Starts a new epoch. Call this after unpublishing a snapshot, and keep the result with
+        /// the snapshot until IsReclaimable returns true for it.
+        /// </summary>
+        /// <returns> The tag of the retired snapshot </returns>
+        static std::uint64_t Retire();
+
+        /// <summary>
+        /// Checks whether every thread that could have seen a snapshot retired with the given
+        /// tag has stopped reading. Scans one record per thread that has ever read.
+        /// </summary>
+        /// <param name="tag"> The tag Retire returned </param>
+        /// <returns> True if the snapshot can be deleted, false otherwise </returns>
+        static bool IsReclaimable(std::uint64_t tag);
+
+    private:
+        /// <summary>
+        /// Reading state of one thread. Records are never freed, only handed to a new thread
+        /// once the one that had it exits.
+        /// </summary>
+        struct alignas(64) Record final
+        {
+            /// <summary>
+            /// The epoch the thread started reading in, or 0 while it isn't reading
+            /// </summary>
+            std::atomic<std::uint64_t> m_epoch{ 0 };
+
+            /// <summary>
+            /// Whether a live thread owns this record
+            /// </summary>
+            std::atomic<bool> m_isInUse{ false };
+
+            /// <summary>
+            /// The next record in the list of every record
+            /// </summary>
+            Record* m_next = nullptr;
+        };
+
+        /// <summary>
+        /// Gets the calling thread's record, claiming one the first time
+        /// </summary>
+        /// <returns> The record of the calling thread </returns>
+        static Record& ThreadRecord();
+
+        /// <summary>
+        /// Claims a free record, or adds a new one to the list
+        /// </summary>
+        /// <returns> The claimed record </returns>
+        static Record& ClaimRecord();
+
+        /// <summary>
+        /// The current epoch. Starts at 1, since 0 marks a thread that isn't reading.
+        /// </summary>
+        inline static std::atomic<std::uint64_t> m_epoch{ 1 };
+
+        /// <summary>
+        /// Head of the list of every record
+        /// </summary>
+        inline static std::atomic<Record*> m_records{ nullptr };
+
+        /// <summary>
+        /// How many Guards are alive on this thread
+        /// </summary>
+        inline static thread_local size_t m_depth = 0;
+    };
+}
@@ -1,6 +1,10 @@
 #include "pch.h"
 #include "Scope.h"
-#include "SList.h"
+#include "DefaultHash.h"
+#include "MemoryUsage.h"
+#include <algorithm>
+#include <future>
+#include <vector>
 
 namespace FieaGameEngine
 {
@@ -8,34 +12,27 @@ namespace FieaGameEngine
 
 #pragma region RuleOf6
     Scope::Scope(size_t capacity)
-        :m_map(capacity)
+        : m_initialCapacity(static_cast<std::uint32_t>(capacity))
     {
     }
 
     Scope::Scope(const Scope& other)
+        : Scope(other, Binding())
     {
-        for (PairType* ptr : other.m_order)
-        {
-            Datum& newDatum = Append(ptr->first);
+    }
 
-            if (ptr->second.Type() == Datum::DatumType::Table)
-            {
-                newDatum.SetType(Datum::DatumType::Table);
-                for (size_t i = 0; i < ptr->second.Size(); ++i)
-                {
-                    Scope* newScope = ptr->second.Get<Scope>(i).Clone();
-                    Adopt(*newScope, ptr->first);
-                }
-            }
-            else
-            {
-                newDatum = ptr->second;
-            }
-        }
+    Scope::Scope(const Scope& other, const Binding& binding)
+    {
+        CopyPairsFrom(other, binding);
     }
 
     Scope::Scope(Scope&& other) noexcept
-        : m_map(std::move(other.m_map)), m_order(std::move(other.m_order)), m_parent(other.m_parent)
+        : Scope(std::move(other), Binding())
+    {
+    }
+
+    Scope::Scope(Scope&& other, const Binding& binding) noexcept
+        : m_parent(other.m_parent), m_order(std::move(other.m_order)), m_index(std::move(other.m_index))
     {
         if (m_parent != nullptr)
         {
@@ -43,44 +40,38 @@ namespace FieaGameEngine
             foundDatum->Set(this, index);
         }
 
-        // Update the parent pointers of all our new children
-        ForEachNestedScopeIn([this](const Scope&, Datum& datum, size_t index)
-            {
-                datum.Get<Scope>(index).m_parent = this;
-                return false;
-            });
+        TakeMovedPairs(other, binding);
 
         other.m_parent = nullptr;
+        ++other.m_structureVersion;
+        if (m_parent != nullptr)
+        {
+            other.OnParentChanged(m_parent);
+        }
     }
 
     Scope& Scope::operator=(const Scope& other)
     {
-        Clear();
-        m_map.Clear();
-        m_order.Clear();
+        Assign(other, Binding());
+        return *this;
+    }
+
+    Scope& Scope::operator=(Scope&& other) noexcept
+    {
+        Assign(std::move(other), Binding());
+        return *this;
+    }
 
-        for (PairType* ptr : other.m_order)
+    void Scope::Assign(const Scope& other, const Binding& binding)
+    {
+        if (this != &other)
         {
-            Datum& newDatum = Append(ptr->first);
-            if (ptr->second.Type() == Datum::DatumType::Table)
-            {
-                newDatum.SetType(Datum::DatumType::Table);
-                for (size_t i = 0; i < ptr->second.Size(); ++i)
-                {
-                    Scope* newScope = ptr->second.Get<Scope>(i).Clone(); 
-                    Adopt(*newScope, ptr->first);
-                }
-            }
-            else
-            {
-                newDatum = ptr->second;
-            }
+            Clear();
+            CopyPairsFrom(other, binding);
         }
-
-        return *this;
     }
 
-    Scope& Scope::operator=(Scope&& other) noexcept
+    void Scope::Assign(Scope&& other, const Binding& binding)
     {
         // Delete all of our children before we override them
         Clear();
@@ -92,8 +83,8 @@ namespace FieaGameEngine
         }
 
         // Steal the data from the other scope
-        m_map = std::move(other.m_map);
         m_order = std::move(other.m_order);
+        m_index = std::move(other.m_index);
         m_parent = other.m_parent;
 
         // If the other scope had a parent, replace it's reference with a pointer to this
@@ -103,16 +94,16 @@ namespace FieaGameEngine
             foundDatum->Set(this, index);
         }
 
-        // Update the parent pointers of all our new children
-        ForEachNestedScopeIn([this](const Scope&, Datum& datum, size_t index)
-            {
-                datum.Get<Scope>(index).m_parent = this;
-                return false;
-            });
+        TakeMovedPairs(other, binding);
         
         other.m_parent = nullptr;
-
-        return *this;
+        ++other.m_structureVersion;
+        ++m_structureVersion;
+        if (m_parent != nullptr)
+        {
+            other.OnParentChanged(m_parent);
+            OnParentChanged(nullptr);
+        }
     }
 
     Scope::~Scope()
@@ -142,14 +133,22 @@ namespace FieaGameEngine
             return false;
         }
 
+        // A ParallelEquals running on this thread splits the nested Scopes across workers
+        return (m_parallelEqualsSubtreeSize != nullptr) ? PairsEqualParallel(*otherScope) : PairsEqual(*otherScope);
+    }
+
+    bool Scope::PairsEqual(const Scope& other) const
+    {
+        // Both Scopes store their pairs contiguously in insert order, so this is a linear walk
         for (size_t i = 0; i < Size(); ++i)
         {
-            if ((*m_order[i]).first == "this")
+            const PairType& pair = m_order[i];
+            if (pair.first == "this")
             {
                 continue;
             }
 
-            if ((*m_order[i]) != (*otherScope->m_order[i]))
+            if (pair != other.m_order[i])
             {
                 return false;
             }
@@ -170,7 +169,7 @@ namespace FieaGameEngine
 
     Datum& Scope::operator[](size_t index)
     {
-        return m_order[index]->second;
+        return m_order[index].second;
     }
 
     Datum& Scope::operator[](const std::string key)
@@ -180,24 +179,24 @@ namespace FieaGameEngine
 
     Datum& Scope::Append(const std::string& key)
     {
-        auto [it, wasInserted] = AppendHelper(key);
-        return it->second;
+        auto [pair, wasInserted] = AppendHelper(key);
+        return pair->second;
     }
 
     Scope& Scope::AppendScope(const std::string& key)
     {
-        auto [it, wasInserted] = AppendHelper(key);
+        auto [pair, wasInserted] = AppendHelper(key);
         if (!wasInserted)
         {
-            if (it->second.Type() != Datum::DatumType::Table)
+            if (pair->second.Type() != Datum::DatumType::Table)
             {
                 throw std::runtime_error("Trying to AppendScope to a Datum whose type isn't table!");
             }
         }
 
         Scope* newScope = new Scope();
-        it->second.SetType(Datum::DatumType::Table);
-        it->second.PushBack(*newScope);
+        pair->second.SetType(Datum::DatumType::Table);
+        pair->second.PushBack(*newScope);
         newScope->m_parent = this;
 
         return *newScope;
@@ -217,10 +216,10 @@ namespace FieaGameEngine
             throw std::runtime_error("Trying to adopt your ancestor or descendant!");
         }
 
-        auto [it, wasInserted] = AppendHelper(key);
+        auto [pair, wasInserted] = AppendHelper(key);
         if (!wasInserted)
         {
-            if (it->second.Type() != Datum::DatumType::Table)
+            if (pair->second.Type() != Datum::DatumType::Table)
             {
                 throw std::runtime_error("Trying to AppendScope to a Datum whose type isn't table!");
             }
@@ -232,9 +231,11 @@ namespace FieaGameEngine
             child.Orphan();
         }
 
-        it->second.SetType(Datum::DatumType::Table);
-        it->second.PushBack(child);
+        pair->second.SetType(Datum::DatumType::Table);
+        pair->second.PushBack(child);
         child.m_parent = this;
+        ++child.m_structureVersion;
+        child.OnParentChanged(nullptr);
     }
 
     void Scope::Orphan()
@@ -244,7 +245,10 @@ namespace FieaGameEngine
             auto [containedDatum, index] = m_parent->FindContainedScope(*this);
             containedDatum->RemoveAt(index);
 
+            Scope* previousParent = m_parent;
             m_parent = nullptr;
+            ++m_structureVersion;
+            OnParentChanged(previousParent);
         }
     }
 
@@ -281,28 +285,14 @@ namespace FieaGameEngine
 
     Datum* Scope::Find(const std::string& key)
     {
-        Datum* value = nullptr;
-        MapIteratorType it = m_map.Find(key);
-
-        if (it != m_map.end())
-        {
-            value = &(it->second);
-        }
-
-        return value;
+        std::uint32_t slot = FindSlot(key);
+        return (slot == EmptySlot) ? nullptr : &(m_order[slot].second);
     }
 
     const Datum* Scope::Find(const std::string& key) const
     {
-        const Datum* value = nullptr;
-        ConstMapIteratorType it = m_map.Find(key);
-
-        if (it != m_map.cend())
-        {
-            value = &(it->second);
-        }
-
-        return value;
+        std::uint32_t slot = FindSlot(key);
+        return (slot == EmptySlot) ? nullptr : &(m_order[slot].second);
     }
 
     std::tuple<Datum*, size_t> Scope::FindContainedScope(const Scope& scopeToFind)
@@ -347,6 +337,10 @@ namespace FieaGameEngine
         return std::make_tuple(foundDatum, this);
     }
 
+    void Scope::OnParentChanged(Scope*)
+    {
+    }
+
     void Scope::Clear()
     {
         ForEachNestedScopeIn([](const Scope&, Datum& datum, size_t index)
@@ -355,8 +349,14 @@ namespace FieaGameEngine
                 return false;
             });
 
-        m_map.Clear();
         m_order.Clear();
+        ++m_structureVersion;
+
+        // Keep the buckets allocated, just mark every one of them as unused
+        for (size_t i = 0; i < m_index.Size(); ++i)
+        {
+            m_index[i] = EmptySlot;
+        }
     }
 
     gsl::owner<Scope*> Scope::Clone() const
@@ -364,11 +364,78 @@ namespace FieaGameEngine
         return new Scope(*this);
     }
 
+    ScopeMemoryUsage Scope::MemoryUsage() const
+    {
+        ScopeMemoryUsage usage;
+        AccumulateMemoryUsage(usage);
+        return usage;
+    }
+
+    MemoryBreakdown Scope::ShallowMemoryUsage() const
+    {
+        // Anything that fits in the small string buffer doesn't touch the heap
+        static const size_t smallStringCapacity = std::string().capacity();
+        auto stringHeapBytes = [](const std::string& str)
+            {
+                return (str.capacity() > smallStringCapacity) ? str.capacity() + 1 : 0;
+            };
+
+        MemoryBreakdown breakdown;
+        breakdown.m_scopeCount = 1;
+        breakdown.m_scopeHeaderBytes = InstanceSize();
+        breakdown.m_indexBucketBytes = m_index.Capacity() * sizeof(std::uint32_t);
+        breakdown.m_orderBytes = m_order.Capacity() * sizeof(PairType);
+        breakdown.m_datumHeaderBytes = m_order.Size() * sizeof(Datum);
+
+        for (const PairType& pair : m_order)
+        {
+            breakdown.m_keyStringHeapBytes += stringHeapBytes(pair.first);
+
+            const Datum& datum = pair.second;
+            if (datum.m_type == Datum::DatumType::Unknown)
+            {
+                continue;
+            }
+
+            if (datum.m_externalStorage)
+            {
+                breakdown.m_externalPayloadBytes += datum.m_size * datum.GetTypeSize();
+            }
+            else
+            {
+                breakdown.m_payloadBytes[static_cast<size_t>(datum.m_type)] += datum.m_capacity * datum.GetTypeSize();
+            }
+
+            if (datum.m_type == Datum::DatumType::String)
+            {
+                for (size_t i = 0; i < datum.m_size; ++i)
+                {
+                    breakdown.m_stringHeapBytes += stringHeapBytes(datum.m_data.s[i]);
+                }
+            }
+        }
+
+        return breakdown;
+    }
+
+    void Scope::AccumulateMemoryUsage(ScopeMemoryUsage& usage) const
+    {
+        MemoryBreakdown breakdown = ShallowMemoryUsage();
+        usage.m_total += breakdown;
+        usage.m_byType[TypeNameInstance()] += breakdown;
+
+        ForEachNestedScopeIn([&usage](const Scope&, Datum& datum, size_t index)
+            {
+                datum.Get<Scope>(index).AccumulateMemoryUsage(usage);
+                return false;
+            });
+    }
+
     void Scope::ForEachNestedScopeIn(NestedScopeFunction func) const
     {
-        for (const auto& pair : m_order)
+        for (const PairType& pair : m_order)
         {
-            Datum& datum = pair->second;
+            Datum& datum = const_cast<Datum&>(pair.second);
             if (datum.Type() == Datum::DatumType::Table)
             {
                 assert(!datum.m_externalStorage);
@@ -384,20 +451,451 @@ namespace FieaGameEngine
         }
     }
 
-    std::tuple<Scope::MapIteratorType, bool> Scope::AppendHelper(const std::string& key)
+    std::tuple<Scope::PairType*, bool> Scope::AppendHelper(const std::string& key)
     {
         if (key == "")
         {
             throw std::runtime_error("Trying to AppendScope with an empty string!");
         }
 
-        PairType newPair = std::make_pair(key, Datum());
-        auto [it, wasInserted] = m_map.Insert(newPair);
-        if (wasInserted)
+        size_t bucket = 0;
+        if (!m_index.IsEmpty())
+        {
+            bucket = FindBucket(key);
+            std::uint32_t slot = m_index[bucket];
+            if (slot != EmptySlot)
+            {
+                return std::make_tuple(&m_order[slot], false);
+            }
+        }
+
+        // Most Scopes stay empty, so the constructor's capacity is only allocated once needed
+        if (m_order.Capacity() == 0 && m_initialCapacity > 0)
+        {
+            m_order.Reserve(m_initialCapacity);
+        }
+
+        // Keep the index at most half full so probe sequences stay short
+        size_t newSize = m_order.Size() + 1;
+        if (newSize * 2 > m_index.Size())
+        {
+            RebuildIndex(std::max(newSize, static_cast<size_t>(m_initialCapacity)) * 2);
+            bucket = FindBucket(key);
+        }
+
+        m_index[bucket] = static_cast<std::uint32_t>(m_order.Size());
+        m_order.PushBack<DoublingIncrement>(PairType(key, Datum()));
+        ++m_structureVersion;
+
+        return std::make_tuple(&m_order.Back(), true);
+    }
+
+    size_t Scope::FindBucket(const std::string& key) const
+    {
+        assert(!m_index.IsEmpty());
+
+        DefaultHash<std::string> hashFunc;
+        size_t mask = m_index.Size() - 1;
+        size_t bucket = hashFunc(key) & mask;
+
+        // Linear probing, the index is never more than half full so this always terminates
+        for (;;)
+        {
+            std::uint32_t slot = m_index[bucket];
+            if (slot == EmptySlot || m_order[slot].first == key)
+            {
+                return bucket;
+            }
+
+            bucket = (bucket + 1) & mask;
+        }
+    }
+
+    std::uint32_t Scope::FindSlot(const std::string& key) const
+    {
+        if (m_index.IsEmpty())
+        {
+            return EmptySlot;
+        }
+
+        return m_index[FindBucket(key)];
+    }
+
+    void Scope::RebuildIndex(size_t bucketCount)
+    {
+        size_t newBucketCount = 8;
+        while (newBucketCount < bucketCount)
+        {
+            newBucketCount *= 2;
+        }
+
+        m_index.Clear();
+        m_index.Resize(newBucketCount);
+        for (size_t i = 0; i < newBucketCount; ++i)
+        {
+            m_index[i] = EmptySlot;
+        }
+
+        for (size_t slot = 0; slot < m_order.Size(); ++slot)
+        {
+            m_index[FindBucket(m_order[slot].first)] = static_cast<std::uint32_t>(slot);
+        }
+    }
+
+    void Scope::CopyPairsFrom(const Scope& other, const Binding& binding)
+    {
+        if (m_parallelCopyThreshold > 0)
+        {
+            CopyPairsFromParallel(other, binding);
+            return;
+        }
+
+        m_order.Reserve(other.m_order.Size());
+
+        for (const PairType& pair : other.m_order)
+        {
+            if (pair.second.Type() == Datum::DatumType::Table)
+            {
+                // Deep copy nested Scopes, parenting the clones directly since the key is already known
+                Datum nestedScopes(Datum::DatumType::Table);
+                if (pair.second.Size() > 0)
+                {
+                    nestedScopes.Reserve(pair.second.Size());
+                }
+
+                for (size_t i = 0; i < pair.second.Size(); ++i)
+                {
+                    Scope* newScope = pair.second.Get<Scope>(i).Clone();
+                    newScope->m_parent = this;
+                    newScope->OnParentChanged(nullptr);
+                    nestedScopes.PushBack(*newScope);
+                }
+
+                m_order.PushBack<DoublingIncrement>(PairType(pair.first, std::move(nestedScopes)));
+            }
+            else
+            {
+                m_order.PushBack<DoublingIncrement>(pair);
+                Rebind(m_order.Size() - 1, binding);
+            }
+        }
+
+        // The pairs were copied into the same slots, so the other Scope's index is valid for us as well
+        m_index = other.m_index;
+    }
+
+    void Scope::CopyPairsFromParallel(const Scope& other, const Binding& binding)
+    {
+        size_t threshold = m_parallelCopyThreshold;
+        m_order.Reserve(other.m_order.Size());
+
+        // Sizes are counted once per parallel copy, at whichever level first needs them
+        Vector<size_t> countedSizes;
+        const size_t* subtreeSize = m_parallelCopySubtreeSize;
+        if (subtreeSize == nullptr)
+        {
+            CountSubtrees(other, countedSizes);
+            subtreeSize = &countedSizes.Front();
+        }
+
+        // Copy the plain pairs and gather every nested Scope in insert order
+        Vector<const Scope*> sources;
+        for (const PairType& pair : other.m_order)
+        {
+            if (pair.second.Type() == Datum::DatumType::Table)
+            {
+                Datum nestedScopes(Datum::DatumType::Table);
+                if (pair.second.Size() > 0)
+                {
+                    nestedScopes.Reserve(pair.second.Size());
+                }
+
+                for (size_t i = 0; i < pair.second.Size(); ++i)
+                {
+                    sources.PushBack<DoublingIncrement>(&pair.second.Get<Scope>(i));
+                }
+
+                m_order.PushBack<DoublingIncrement>(PairType(pair.first, std::move(nestedScopes)));
+            }
+            else
+            {
+                m_order.PushBack<DoublingIncrement>(pair);
+                Rebind(m_order.Size() - 1, binding);
+            }
+        }
+
+        // Large subtrees go to worker threads, small ones are cloned right here with parallel copying off
+        Vector<Scope*> clones;
+        clones.Resize(sources.Size());
+        std::vector<std::pair<size_t, std::future<Scope*>>> pending;
+
+        std::exception_ptr failure;
+        try
+        {
+            const size_t* childSize = subtreeSize + 1;
+            for (size_t i = 0; i < sources.Size(); ++i)
+            {
+                const Scope* source = sources[i];
+                const size_t* sourceSize = childSize;
+                childSize += *sourceSize;
+
+                if (*sourceSize >= threshold)
+                {
+                    pending.emplace_back(i, std::async(std::launch::async, [source, threshold, sourceSize]()
+                        {
+                            ParallelCopyGuard guard(threshold, sourceSize);
+                            return static_cast<Scope*>(source->Clone());
+                        }));
+                }
+                else
+                {
+                    ParallelCopyGuard guard(0);
+                    clones[i] = source->Clone();
+                }
+            }
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+
+        // Every worker has to finish, even after a failure, before its clone can be reclaimed
+        for (auto& [index, future] : pending)
+        {
+            try
+            {
+                clones[index] = future.get();
+            }
+            catch (...)
+            {
+                if (failure == nullptr)
+                {
+                    failure = std::current_exception();
+                }
+            }
+        }
+
+        if (failure != nullptr)
+        {
+            // None of the clones were adopted yet, so they are ours alone to delete
+            for (Scope* clone : clones)
+            {
+                delete clone;
+            }
+
+            m_order.Clear();
+            std::rethrow_exception(failure);
+        }
+
+        // Stitch the clones back in the same order they were gathered in
+        size_t nextClone = 0;
+        for (size_t slot = 0; slot < m_order.Size(); ++slot)
+        {
+            Datum& datum = m_order[slot].second;
+            if (datum.Type() == Datum::DatumType::Table)
+            {
+                for (size_t i = 0; i < other.m_order[slot].second.Size(); ++i)
+                {
+                    Scope* newScope = clones[nextClone++];
+                    newScope->m_parent = this;
+                    newScope->OnParentChanged(nullptr);
+                    datum.PushBack(*newScope);
+                }
+            }
+        }
+
+        m_index = other.m_index;
+    }
+
+    void Scope::TakeMovedPairs(Scope& other, const Binding& binding)
+    {
+        for (size_t slot = 0; slot < m_order.Size(); ++slot)
+        {
+            Datum& datum = m_order[slot].second;
+            if (datum.Type() == Datum::DatumType::Table)
+            {
+                // Update the parent pointers of all our new children
+                for (size_t i = 0; i < datum.Size(); ++i)
+                {
+                    Scope& child = datum.Get<Scope>(i);
+                    child.m_parent = this;
+                    ++child.m_structureVersion;
+                    child.OnParentChanged(&other);
+                }
+            }
+            else
+            {
+                Rebind(slot, binding);
+            }
+        }
+    }
+
+    void Scope::Rebind(size_t slot, const Binding& binding)
+    {
+        Datum& datum = m_order[slot].second;
+        if (slot >= binding.m_count || !datum.m_externalStorage)
         {
-            m_order.PushBack(&(*it));
+            return;
         }
 
-        return std::make_tuple(it, wasInserted);
+        std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(datum.m_data.vp) - reinterpret_cast<std::uintptr_t>(binding.m_source);
+        datum.m_data.vp = reinterpret_cast<std::uint8_t*>(this) + offset;
     }
+
+#pragma region Parallel
+    Scope::ParallelCopyGuard::ParallelCopyGuard(size_t serialThreshold)
+        : ParallelCopyGuard(serialThreshold, nullptr)
+    {
+    }
+
+    Scope::ParallelCopyGuard::ParallelCopyGuard(size_t serialThreshold, const size_t* subtreeSize)
+        : m_previousThreshold(m_parallelCopyThreshold), m_previousSubtreeSize(m_parallelCopySubtreeSize)
+    {
+        m_parallelCopyThreshold = serialThreshold;
+        m_parallelCopySubtreeSize = subtreeSize;
+    }
+
+    Scope::ParallelCopyGuard::~ParallelCopyGuard()
+    {
+        m_parallelCopyThreshold = m_previousThreshold;
+        m_parallelCopySubtreeSize = m_previousSubtreeSize;
+    }
+
+    Scope::ParallelEqualsGuard::ParallelEqualsGuard(size_t serialThreshold, const size_t* subtreeSize)
+        : m_previousThreshold(m_parallelEqualsThreshold), m_previousSubtreeSize(m_parallelEqualsSubtreeSize)
+    {
+        m_parallelEqualsThreshold = serialThreshold;
+        m_parallelEqualsSubtreeSize = subtreeSize;
+    }
+
+    Scope::ParallelEqualsGuard::~ParallelEqualsGuard()
+    {
+        m_parallelEqualsThreshold = m_previousThreshold;
+        m_parallelEqualsSubtreeSize = m_previousSubtreeSize;
+    }
+
+    gsl::owner<Scope*> Scope::ParallelClone(size_t serialThreshold) const
+    {
+        Vector<size_t> sizes;
+        CountSubtrees(*this, sizes);
+
+        ParallelCopyGuard guard((sizes.Front() >= serialThreshold) ? serialThreshold : 0, &sizes.Front());
+        return Clone();
+    }
+
+    bool Scope::ParallelEquals(const Scope& other, size_t serialThreshold) const
+    {
+        Vector<size_t> sizes;
+        CountSubtrees(*this, sizes);
+
+        ParallelEqualsGuard guard(serialThreshold, &sizes.Front());
+        return Equals(&other);
+    }
+
+    bool Scope::PairsEqualParallel(const Scope& other) const
+    {
+        size_t serialThreshold = m_parallelEqualsThreshold;
+        const size_t* subtreeSize = m_parallelEqualsSubtreeSize;
+
+        // Only this Scope reads the counted sizes, anything nested compared here is serial
+        ParallelEqualsGuard serialGuard(0, nullptr);
+        if (*subtreeSize < serialThreshold)
+        {
+            return PairsEqual(other);
+        }
+
+        bool isEqual = true;
+        std::vector<std::future<bool>> pending;
+        const size_t* childSize = subtreeSize + 1;
+
+        for (size_t slot = 0; slot < Size() && isEqual; ++slot)
+        {
+            const PairType& pair = m_order[slot];
+            const PairType& otherPair = other.m_order[slot];
+
+            if (pair.first == "this")
+            {
+                continue;
+            }
+
+            const Datum& datum = pair.second;
+            const Datum& otherDatum = otherPair.second;
+            bool areNestedScopes = (datum.Type() == Datum::DatumType::Table && otherDatum.Type() == Datum::DatumType::Table);
+
+            if (pair.first != otherPair.first || !areNestedScopes || datum.Size() != otherDatum.Size())
+            {
+                isEqual = (pair == otherPair);
+
+                // Step over the sizes of any nested Scopes compared serially here
+                if (datum.Type() == Datum::DatumType::Table)
+                {
+                    for (size_t i = 0; i < datum.Size(); ++i)
+                    {
+                        childSize += *childSize;
+                    }
+                }
+
+                continue;
+            }
+
+            // Compare large nested subtrees on worker threads and small ones right here
+            for (size_t i = 0; i < datum.Size() && isEqual; ++i)
+            {
+                const Scope& child = datum.Get<Scope>(i);
+                const Scope& otherChild = otherDatum.Get<Scope>(i);
+                const size_t* size = childSize;
+                childSize += *size;
+
+                if (*size >= serialThreshold)
+                {
+                    pending.push_back(std::async(std::launch::async, [&child, &otherChild, serialThreshold, size]()
+                        {
+                            ParallelEqualsGuard guard(serialThreshold, size);
+                            return child.Equals(&otherChild);
+                        }));
+                }
+                else
+                {
+                    isEqual = child.Equals(&otherChild);
+                }
+            }
+        }
+
+        // Every worker has to finish before we return since they reference our children
+        for (std::future<bool>& result : pending)
+        {
+            isEqual = result.get() && isEqual;
+        }
+
+        return isEqual;
+    }
+
+    size_t Scope::CountSubtrees(const Scope& scope, Vector<size_t>& sizes)
+    {
+        size_t entry = sizes.Size();
+        sizes.PushBack<DoublingIncrement>(0);
+
+        size_t count = 1;
+        scope.ForEachNestedScopeIn([&count, &sizes](const Scope&, Datum& datum, size_t index)
+            {
+                count += CountSubtrees(datum.Get<Scope>(index), sizes);
+                return false;
+            });
+
+        sizes[entry] = count;
+        return count;
+    }
+
+    size_t Scope::NodeCount() const
+    {
+        size_t count = 1;
+        ForEachNestedScopeIn([&count](const Scope&, Datum& datum, size_t index)
+            {
+                count += datum.Get<Scope>(index).NodeCount();
+                return false;
+            });
+
+        return count;
+    }
+#pragma endregion
 }
\ No newline at end of file
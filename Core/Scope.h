@@ -1,31 +1,41 @@
 #pragma once
-#include "HashMap.h"
+#include "Vector.h"
 #include "Datum.h"
 #include "RTTI.h"
 #include <functional>
+#include <cstdint>
 #include <gsl/gsl>
 #include "Factory.h"
 
 namespace FieaGameEngine
 {
+	struct MemoryBreakdown;
+	struct ScopeMemoryUsage;
+
+	/// <summary>
+	/// Table of named Datums, kept in insert order, that can nest further Scopes. Pairs are
+	/// stored contiguously, so appending a new key through Append, AppendScope, Adopt or
+	/// operator[] may move every pair. Any Datum reference or pointer taken from operator[],
+	/// Append or Find is invalidated by that, and must be looked up again afterwards.
+	/// </summary>
 	class Scope : public FieaGameEngine::RTTI
 	{
 		friend Attributed;
 
 		RTTI_DECLARATIONS(Scope, RTTI);
 	public:
-		using MapType = HashMap<const std::string, Datum>;
-		using MapIteratorType = MapType::Iterator;
-		using ConstMapIteratorType = MapType::ConstIterator;
 		using PairType = std::pair<const std::string, Datum>;
+		using OrderType = Vector<PairType>;
+		using IndexType = Vector<std::uint32_t>;
 		using NestedScopeFunction = std::function<bool(const Scope&, Datum&, size_t)>;
 
 		#pragma region RuleOf6
 		/// <summary>
 		/// Default constructor with optional starting capacity parameter
 		/// </summary>
-		/// <param name="capacity"> Optional capacity parameter that defines the starting
-		/// size of the inner hashmap "bucket" array </param>
+		/// <param name="capacity"> Optional capacity parameter that defines how many
+		/// entries the Scope can hold before its pair storage has to grow. Nothing is
+		/// allocated until the first pair is appended. </param>
 		explicit Scope(size_t capacity = 11);
 
 		/// <summary>
@@ -92,7 +102,8 @@ namespace FieaGameEngine
 
 		/// <summary>
 		/// Gets the Datum at the given index and returns it. The index given corresponds to the 
-		/// insert order.
+		/// insert order. Entries are stored contiguously, so any Datum reference is invalidated 
+		/// by appending a new key to this Scope.
 		/// </summary>
 		/// <param name="index"> The index to retrieve </param>
 		/// <returns> A reference to the Datum found at the index </returns>
@@ -104,7 +115,8 @@ namespace FieaGameEngine
 		/// </summary>
 		/// <param name="key"> The key to use for insertion </param>
 		/// <returns> A reference to the appended Datum in the case of insertion. If the key already 
-		/// existed, a reference to the existing Datum is returned. </returns>
+		/// existed, a reference to the existing Datum is returned. Invalidated by appending any
+		/// new key to this Scope. </returns>
         Datum& operator[](const std::string key);
 
         /// <summary>
@@ -113,7 +125,9 @@ namespace FieaGameEngine
         /// </summary>
         /// <param name="key"> The key to use for insertion </param>
         /// <returns> A reference to the appended Datum in the case of insertion. If the key already 
-        /// existed, a reference to the existing Datum is returned. </returns>
+        /// existed, a reference to the existing Datum is returned. Invalidated by appending any
+        /// new key to this Scope, so don't hold on to it across another Append, AppendScope or
+        /// Adopt. </returns>
         /// <exception cref="std::runtime_error"> Throws if the key is an empty string </exception>
 		Datum& Append(const std::string& key);
 
@@ -184,7 +198,8 @@ namespace FieaGameEngine
 		/// of nested Scopes or parent Scopes, just this one.
 		/// </summary>
 		/// <param name="key"> The key to search for </param>
-		/// <returns> A pointer to the found Datum, or nullptr if nothing was found </returns>
+		/// <returns> A pointer to the found Datum, or nullptr if nothing was found. Invalidated by
+		/// appending any new key to this Scope. </returns>
 		Datum* Find(const std::string& key);
 
         /// <summary>
@@ -192,7 +207,8 @@ namespace FieaGameEngine
         /// of nested Scopes or parent Scopes, just this one.
         /// </summary>
         /// <param name="key"> The key to search for </param>
-        /// <returns> A pointer to the found const Datum, or nullptr if nothing was found </returns>
+        /// <returns> A pointer to the found const Datum, or nullptr if nothing was found.
+        /// Invalidated by appending any new key to this Scope. </returns>
 		const Datum* Find(const std::string& key) const;
 
 		/// <summary>
@@ -232,24 +248,339 @@ namespace FieaGameEngine
 
 		virtual gsl::owner<Scope*> Clone() const;
 
+		/// <summary>
+		/// Measures the memory used by this Scope and all of its nested Scopes, both as a total
+		/// and grouped by the RTTI type name of each node. See MemoryUsage.h.
+		/// </summary>
+		/// <returns> The recursive memory usage of this Scope tree </returns>
+		ScopeMemoryUsage MemoryUsage() const;
+
+		/// <summary>
+		/// Default number of nodes a Scope tree needs before the parallel copy and equality
+		/// methods split it across worker threads
+		/// </summary>
+		static const size_t DefaultParallelThreshold = 4096;
+
+		/// <summary>
+		/// RAII guard that makes every Scope copy constructed on this thread, while the guard is
+		/// alive, clone large nested subtrees on worker threads. Nested Scopes whose subtree holds
+		/// fewer nodes than the threshold are cloned serially. Clones are always stitched back
+		/// into their parent in insert order, so the result is identical to a serial copy.
+		/// </summary>
+		class ParallelCopyGuard final
+		{
+		public:
+			/// <summary>
+			/// Enables parallel copying on this thread
+			/// </summary>
+			/// <param name="serialThreshold"> Subtrees with fewer nodes than this are copied
+			/// serially. Zero disables parallel copying. </param>
+			explicit ParallelCopyGuard(size_t serialThreshold = DefaultParallelThreshold);
+
+			ParallelCopyGuard(const ParallelCopyGuard&) = delete;
+			ParallelCopyGuard& operator=(const ParallelCopyGuard&) = delete;
+
+			/// <summary>
+			/// Restores whatever parallel copy setting this thread had before the guard
+			/// </summary>
+			~ParallelCopyGuard();
+
+		private:
+			friend class Scope;
+
+			/// <summary>
+			/// Enables parallel copying on this thread for a copy whose subtree sizes were
+			/// already counted
+			/// </summary>
+			/// <param name="serialThreshold"> Subtrees with fewer nodes than this are copied
+			/// serially. Zero disables parallel copying. </param>
+			/// <param name="subtreeSize"> The counted size of the Scope about to be copied, see
+			/// CountSubtrees </param>
+			ParallelCopyGuard(size_t serialThreshold, const size_t* subtreeSize);
+
+			/// <summary>
+			/// The threshold that was active before this guard was created
+			/// </summary>
+			size_t m_previousThreshold;
+
+			/// <summary>
+			/// The counted subtree size that was active before this guard was created
+			/// </summary>
+			const size_t* m_previousSubtreeSize;
+		};
+
+		/// <summary>
+		/// Clones this Scope, cloning independent nested subtrees on worker threads when the tree 
+		/// is large enough. The result is identical to Clone().
+		/// </summary>
+		/// <param name="serialThreshold"> Trees and subtrees with fewer nodes than this are
+		/// cloned serially </param>
+		/// <returns> The newly heap allocated clone </returns>
+		gsl::owner<Scope*> ParallelClone(size_t serialThreshold = DefaultParallelThreshold) const;
+
+		/// <summary>
+		/// Equivalent to operator==, but compares independent nested subtrees on worker threads
+		/// when the tree is large enough
+		/// </summary>
+		/// <param name="other"> The other Scope to compare to </param>
+		/// <param name="serialThreshold"> Trees and subtrees with fewer nodes than this are
+		/// compared serially </param>
+		/// <returns> True if the two Scopes are equal, false otherwise </returns>
+		bool ParallelEquals(const Scope& other, size_t serialThreshold = DefaultParallelThreshold) const;
+
+		/// <summary>
+		/// Counts this Scope and every Scope nested beneath it
+		/// </summary>
+		/// <returns> The number of Scopes in this tree </returns>
+		size_t NodeCount() const;
+
+		/// <summary>
+		/// Measures the memory used by this Scope alone, not counting nested Scopes
+		/// </summary>
+		/// <returns> The memory breakdown of this Scope </returns>
+		MemoryBreakdown ShallowMemoryUsage() const;
+
+		/// <summary>
+		/// Gets a counter that changes whenever this Scope gains pairs, loses pairs, is moved
+		/// or is re-parented. A Datum pointer found by Search stays valid for as long as the
+		/// versions of every Scope the search passed through are unchanged. See DatumHandle.
+		/// </summary>
+		/// <returns> The current structure version of this Scope </returns>
+		std::uint32_t StructureVersion() const { return m_structureVersion; }
+
 	protected:
+		/// <summary>
+		/// Describes the leading pairs of a Scope whose Datums use external storage inside the
+		/// object that holds them, so copies and moves can rebase that storage onto the new
+		/// object while they copy or take over the pairs, without a second pass
+		/// </summary>
+		struct Binding final
+		{
+			/// <summary>
+			/// The Scope the source storage points into, or nullptr if it holds offsets
+			/// </summary>
+			const Scope* m_source = nullptr;
+
+			/// <summary>
+			/// How many leading pairs may hold bound storage
+			/// </summary>
+			size_t m_count = 0;
+		};
+
+		/// <summary>
+		/// Copy constructor that rebases bound storage onto this Scope
+		/// </summary>
+		/// <param name="other"> The Scope to copy </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		Scope(const Scope& other, const Binding& binding);
+
+		/// <summary>
+		/// Move constructor that rebases bound storage onto this Scope
+		/// </summary>
+		/// <param name="other"> The Scope to move </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		Scope(Scope&& other, const Binding& binding) noexcept;
+
+		/// <summary>
+		/// Copy assignment that rebases bound storage onto this Scope
+		/// </summary>
+		/// <param name="other"> The Scope to copy </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		void Assign(const Scope& other, const Binding& binding);
+
+		/// <summary>
+		/// Move assignment that rebases bound storage onto this Scope
+		/// </summary>
+		/// <param name="other"> The Scope to move </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		void Assign(Scope&& other, const Binding& binding);
+
 		/// <summary>
 		/// This Scope's parent Scope (or nullptr if this is a root Scope)
 		/// </summary>
 		Scope* m_parent = nullptr;
 
 		/// <summary>
-		/// Internal hashmap used to store string, Datum pairs to keep track of all children
+		/// Internal vector that owns every string, Datum pair of this Scope. Pairs are stored
+		/// contiguously in the order they were inserted, so ordered walks are linear scans.
 		/// </summary>
-		MapType m_map;
+		OrderType m_order;
 
 		/// <summary>
-		/// Internal vector used to keep the order of inserted pairs (since the hashmap is unordered
-		/// we would have no way of tracking the order things were inserted without this)
+		/// Open addressed hash index into m_order. Each bucket holds the slot of a pair in
+		/// m_order, or EmptySlot. The bucket count is always zero or a power of two.
 		/// </summary>
-		Vector<PairType*> m_order;
+		IndexType m_index;
+
+		/// <summary>
+		/// Called whenever this Scope's parent changes, through Adopt, Orphan, moves, or being
+		/// cloned into a copied parent. Does nothing here; derived classes that index themselves
+		/// by parent override it.
+		/// </summary>
+		/// <param name="previousParent"> The parent this Scope had before, possibly nullptr </param>
+		virtual void OnParentChanged(Scope* previousParent);
 
 	private:
+		/// <summary>
+		/// Subtree size at which copies made on this thread go parallel, zero when copies are
+		/// serial. Set through ParallelCopyGuard.
+		/// </summary>
+		inline static thread_local size_t m_parallelCopyThreshold = 0;
+
+		/// <summary>
+		/// Counted size of the Scope the next parallel copy on this thread copies from, inside
+		/// a table built by CountSubtrees. Nullptr when the copy has to count for itself.
+		/// </summary>
+		inline static thread_local const size_t* m_parallelCopySubtreeSize = nullptr;
+
+		/// <summary>
+		/// Counter behind StructureVersion
+		/// </summary>
+		std::uint32_t m_structureVersion = 0;
+
+		/// <summary>
+		/// The capacity asked for at construction, allocated by the first append
+		/// </summary>
+		std::uint32_t m_initialCapacity = 0;
+
+		/// <summary>
+		/// Sentinel value marking an unused bucket in the hash index
+		/// </summary>
+		static const std::uint32_t EmptySlot = UINT32_MAX;
+
+		/// <summary>
+		/// Finds the bucket in the hash index that either holds the given key or is the empty
+		/// bucket the key would be inserted into. Must not be called on an empty index.
+		/// </summary>
+		/// <param name="key"> The key to look for </param>
+		/// <returns> The bucket position in m_index </returns>
+		size_t FindBucket(const std::string& key) const;
+
+		/// <summary>
+		/// Finds the slot in m_order that holds the given key
+		/// </summary>
+		/// <param name="key"> The key to look for </param>
+		/// <returns> The slot of the pair in m_order, or EmptySlot if the key isn't in this Scope </returns>
+		std::uint32_t FindSlot(const std::string& key) const;
+
+		/// <summary>
+		/// Rebuilds the hash index with at least the given number of buckets, reinserting the
+		/// slot of every pair currently in m_order
+		/// </summary>
+		/// <param name="bucketCount"> The minimum number of buckets (rounded up to a power of two) </param>
+		void RebuildIndex(size_t bucketCount);
+
+		/// <summary>
+		/// Helper function used by the copy constructor and copy assignment that deep copies every
+		/// pair of the other Scope into this (empty) Scope, cloning nested Scopes
+		/// </summary>
+		/// <param name="other"> The Scope to copy from </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		void CopyPairsFrom(const Scope& other, const Binding& binding);
+
+		/// <summary>
+		/// Parallel version of CopyPairsFrom used while a ParallelCopyGuard is active. Large
+		/// nested subtrees are cloned on worker threads and then adopted in insert order.
+		/// </summary>
+		/// <param name="other"> The Scope to copy from </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		void CopyPairsFromParallel(const Scope& other, const Binding& binding);
+
+		/// <summary>
+		/// Helper function used by the move constructor and move assignment once this Scope has
+		/// taken the other's pairs. Reparents every nested Scope and rebases bound storage.
+		/// </summary>
+		/// <param name="other"> The Scope that was moved from </param>
+		/// <param name="binding"> The bound pairs of other </param>
+		void TakeMovedPairs(Scope& other, const Binding& binding);
+
+		/// <summary>
+		/// Points a copied or moved pair's bound storage at this Scope instead of the source.
+		/// Does nothing for pairs past the binding or without external storage.
+		/// </summary>
+		/// <param name="slot"> The slot of the pair in m_order </param>
+		/// <param name="binding"> The binding the pair was copied or moved under </param>
+		void Rebind(size_t slot, const Binding& binding);
+
+		/// <summary>
+		/// Counts every subtree of a Scope in a single pass. Sizes are appended in pre-order, so
+		/// a Scope's first nested Scope follows it directly and each later one follows the whole
+		/// subtree of the one before: the entry after child is child + *child.
+		/// </summary>
+		/// <param name="scope"> The root of the subtrees to count </param>
+		/// <param name="sizes"> The table to append the sizes to </param>
+		/// <returns> The number of Scopes in the tree </returns>
+		static size_t CountSubtrees(const Scope& scope, Vector<size_t>& sizes);
+
+		/// <summary>
+		/// Compares the pairs of two Scopes of the same size one after another
+		/// </summary>
+		/// <param name="other"> The other Scope to compare to </param>
+		/// <returns> True if every pair is equal, false otherwise </returns>
+		bool PairsEqual(const Scope& other) const;
+
+		/// <summary>
+		/// Parallel version of PairsEqual used while a ParallelEqualsGuard is active. Large
+		/// nested subtrees are compared on worker threads through their own Equals.
+		/// </summary>
+		/// <param name="other"> The other Scope to compare to </param>
+		/// <returns> True if every pair is equal, false otherwise </returns>
+		bool PairsEqualParallel(const Scope& other) const;
+
+		/// <summary>
+		/// RAII guard that hands the counted subtree sizes of a ParallelEquals to the next
+		/// Scope::Equals on this thread, so the comparison goes through any derived override
+		/// </summary>
+		class ParallelEqualsGuard final
+		{
+		public:
+			/// <summary>
+			/// Enables parallel comparison on this thread
+			/// </summary>
+			/// <param name="serialThreshold"> Subtrees with fewer nodes than this are compared
+			/// serially </param>
+			/// <param name="subtreeSize"> The counted size of the Scope about to be compared, see
+			/// CountSubtrees. Nullptr disables parallel comparison. </param>
+			ParallelEqualsGuard(size_t serialThreshold, const size_t* subtreeSize);
+
+			ParallelEqualsGuard(const ParallelEqualsGuard&) = delete;
+			ParallelEqualsGuard& operator=(const ParallelEqualsGuard&) = delete;
+
+			/// <summary>
+			/// Restores whatever parallel comparison setting this thread had before the guard
+			/// </summary>
+			~ParallelEqualsGuard();
+
+		private:
+			/// <summary>
+			/// The threshold that was active before this guard was created
+			/// </summary>
+			size_t m_previousThreshold;
+
+			/// <summary>
+			/// The counted subtree size that was active before this guard was created
+			/// </summary>
+			const size_t* m_previousSubtreeSize;
+		};
+
+		/// <summary>
+		/// Subtree size below which the parallel comparison on this thread goes serial. Set
+		/// through ParallelEqualsGuard.
+		/// </summary>
+		inline static thread_local size_t m_parallelEqualsThreshold = 0;
+
+		/// <summary>
+		/// Counted size of the Scope the next Equals on this thread compares, inside a table
+		/// built by CountSubtrees. Nullptr when comparisons are serial.
+		/// </summary>
+		inline static thread_local const size_t* m_parallelEqualsSubtreeSize = nullptr;
+
+		/// <summary>
+		/// Helper function that adds the memory usage of this Scope and its nested Scopes into
+		/// the given usage
+		/// </summary>
+		/// <param name="usage"> The usage to accumulate into </param>
+		void AccumulateMemoryUsage(ScopeMemoryUsage& usage) const;
 
 		/// <summary>
 		/// Helper function that enacts the given function on every nested Scope inside this Scope
@@ -258,14 +589,14 @@ namespace FieaGameEngine
 		void ForEachNestedScopeIn(NestedScopeFunction func) const;
 
 		/// <summary>
-		/// Helper function that attempts to append the given key to the hashmap with a default
+		/// Helper function that attempts to append the given key to this Scope with a default
 		/// constructed Datum.
 		/// </summary>
 		/// <param name="key"> The key to use for insertion </param>
-		/// <returns> A std::tuple with a hashmap iterator pointing to the newly created pair or to
-		/// the existing pair if the key already exists. The second part is a boolean that is true if
-		/// the pair was inserted and false if the pair already existed </returns>
-		std::tuple<MapIteratorType, bool> AppendHelper(const std::string& key);
+		/// <returns> A std::tuple with a pointer to the newly created pair or to the existing pair 
+		/// if the key already exists. The second part is a boolean that is true if the pair was 
+		/// inserted and false if the pair already existed </returns>
+		std::tuple<PairType*, bool> AppendHelper(const std::string& key);
 	};
 
 	ConcreteFactory(Scope, Scope);
@@ -1,75 +1,298 @@
 #include "pch.h"
 #include "TypeManager.h"
+#include "Attributed.h"
+#include <algorithm>
 
 
 namespace FieaGameEngine
 {
-    HashMap<RTTI::IdType, TypeManager::TypeInfo> TypeManager::m_types;
+    TypeManager::TypeMap TypeManager::m_types;
+    std::mutex TypeManager::m_mutex;
+    std::atomic<bool> TypeManager::m_isDirty{ false };
+    std::atomic<const TypeManager::LayoutMap*> TypeManager::m_published{ nullptr };
+    Vector<TypeManager::RetiredSnapshot> TypeManager::m_retired;
+    Vector<gsl::owner<TypeLayout*>> TypeManager::m_retiredLayouts;
 
-    const Vector<Signature> TypeManager::GetSignatures(RTTI::IdType typeId)
+    const Vector<StaticSignature>& TypeManager::GetSignatures(RTTI::IdType typeId)
     {
-        auto it = m_types.Find(typeId);
+        return GetLayout(typeId).m_signatures;
+    }
 
-        if (it == m_types.end())
+    const TypeLayout& TypeManager::GetLayout(RTTI::IdType typeId)
+    {
+        ReadEpoch::Guard guard;
+        const LayoutMap& layouts = Snapshot();
+        auto it = layouts.Find(typeId);
+
+        if (it == layouts.end())
         {
             throw std::exception("Trying to get signatures for a type that isn't registered!");
         }
 
-        Vector<Signature> signatures;
+        // Layouts outlive the snapshot that points to them
+        return *it->second;
+    }
 
-        // If our parent type is in the type manager, recursively get all of the inherited members first
-        if (ContainsType(it->second.m_parentType))
-        {
-            signatures = GetSignatures(it->second.m_parentType);
-        }
+    bool TypeManager::ContainsType(RTTI::IdType typeId)
+    {
+        ReadEpoch::Guard guard;
+        const LayoutMap& layouts = Snapshot();
+        return (layouts.Find(typeId) != layouts.end());
+    }
+
+    bool TypeManager::AddType(RTTI::IdType typeId, const Vector<Signature>& signatures, RTTI::IdType parentType)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TypeInfo* typeInfo = InsertType(typeId, parentType);
 
-        // Now append all of our signatures to that list 
-        for (Signature& signature : it->second.m_signatures)
+        if (typeInfo != nullptr)
         {
-            signatures.PushBack(signature);
+            typeInfo->m_signatures = signatures;
         }
 
-        return signatures;
+        return typeInfo != nullptr;
     }
 
-    bool TypeManager::ContainsType(RTTI::IdType typeId)
+    bool TypeManager::AddType(RTTI::IdType typeId, gsl::span<const StaticSignature> signatures, RTTI::IdType parentType)
     {
-        return m_types.ContainsKey(typeId);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TypeInfo* typeInfo = InsertType(typeId, parentType);
+
+        if (typeInfo != nullptr)
+        {
+            typeInfo->m_staticSignatures = signatures;
+        }
+
+        return typeInfo != nullptr;
     }
 
-    bool TypeManager::AddType(RTTI::IdType typeId, const Vector<Signature>& signatures, RTTI::IdType parentType)
+    bool TypeManager::RemoveType(RTTI::IdType typeId)
     {
-        if (typeId == parentType)
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_types.Find(typeId);
+        if (it == m_types.end())
         {
-            throw std::exception("Trying to add a type whose parent type is itself!");
+            return false;
         }
 
-        auto [it, wasInserted] = m_types.Insert(std::make_pair(typeId, TypeInfo()));
+        // Descendants lose the removed type's signatures
+        for (auto& [otherId, typeInfo] : m_types)
+        {
+            if (otherId != typeId && DescendsFrom(otherId, typeId))
+            {
+                typeInfo.m_isStale = true;
+            }
+        }
 
-        if (wasInserted)
+        if (it->second.m_layout != nullptr)
         {
-            it->second.m_signatures = signatures;
-            it->second.m_parentType = parentType;
+            m_retiredLayouts.PushBack(it->second.m_layout);
         }
 
-        return wasInserted;
+        m_types.Remove(typeId);
+        m_isDirty.store(true, std::memory_order_release);
+
+        return true;
     }
 
-    bool TypeManager::RemoveType(RTTI::IdType typeId)
+    void TypeManager::Publish()
     {
-        return m_types.Remove(typeId);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        PublishLocked();
     }
 
     void TypeManager::Clear()
     {
-        if (Size() > 0)
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto& [typeId, typeInfo] : m_types)
+        {
+            delete typeInfo.m_layout;
+        }
+
+        if (m_types.Size() > 0)
         {
             m_types.Clear();
-        } 
+        }
+
+        delete m_published.exchange(nullptr, std::memory_order_acq_rel);
+        for (const RetiredSnapshot& retired : m_retired)
+        {
+            delete retired.m_layouts;
+        }
+        m_retired.Clear();
+
+        for (TypeLayout* layout : m_retiredLayouts)
+        {
+            delete layout;
+        }
+        m_retiredLayouts.Clear();
+
+        m_isDirty.store(false, std::memory_order_release);
     }
 
     size_t TypeManager::Size()
     {
-        return m_types.Size();
+        ReadEpoch::Guard guard;
+        return Snapshot().Size();
+    }
+
+    const TypeManager::LayoutMap& TypeManager::Snapshot()
+    {
+        if (m_isDirty.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Another reader may have published while we waited for the lock
+            if (m_isDirty.load(std::memory_order_relaxed))
+            {
+                PublishLocked();
+            }
+        }
+
+        const LayoutMap* layouts = m_published.load();
+        if (layouts == nullptr)
+        {
+            static const LayoutMap emptyLayouts;
+            return emptyLayouts;
+        }
+
+        return *layouts;
+    }
+
+    void TypeManager::PublishLocked()
+    {
+        RebuildStaleLayouts();
+
+        // The snapshot only points to the layouts, so it is cheap to build
+        LayoutMap* snapshot = new LayoutMap(std::max<size_t>(m_types.Size(), 11));
+        for (const auto& [typeId, typeInfo] : m_types)
+        {
+            snapshot->Insert(std::make_pair(typeId, typeInfo.m_layout));
+        }
+
+        const LayoutMap* previous = m_published.exchange(snapshot);
+        if (previous != nullptr)
+        {
+            m_retired.PushBack({ previous, ReadEpoch::Retire() });
+        }
+
+        // Snapshots are retired in order, so the reclaimable ones are at the front
+        size_t reclaimed = 0;
+        while (reclaimed < m_retired.Size() && ReadEpoch::IsReclaimable(m_retired[reclaimed].m_tag))
+        {
+            delete m_retired[reclaimed].m_layouts;
+            ++reclaimed;
+        }
+
+        if (reclaimed > 0)
+        {
+            m_retired.Remove(m_retired.begin(), m_retired.begin() + reclaimed);
+        }
+
+        m_isDirty.store(false, std::memory_order_release);
+    }
+
+    void TypeManager::RebuildStaleLayouts()
+    {
+        // Find every type to rebuild before clearing any flags, since descendants check their ancestors
+        Vector<std::pair<RTTI::IdType, TypeInfo*>> stale;
+        for (auto& [typeId, typeInfo] : m_types)
+        {
+            if (NeedsRebuild(typeId))
+            {
+                stale.PushBack(std::make_pair(typeId, &typeInfo));
+            }
+        }
+
+        for (auto& [typeId, typeInfo] : stale)
+        {
+            TypeLayout* layout = new TypeLayout();
+            FlattenSignatures(typeId, *layout);
+            layout->m_prescribedCount = layout->m_signatures.Size() + 1;
+            Attributed::BuildPrototype(layout->m_signatures, layout->m_prototype);
+
+            if (typeInfo->m_layout != nullptr)
+            {
+                m_retiredLayouts.PushBack(typeInfo->m_layout);
+            }
+            typeInfo->m_layout = layout;
+        }
+
+        for (auto& [typeId, typeInfo] : stale)
+        {
+            typeInfo->m_isStale = false;
+        }
+    }
+
+    bool TypeManager::DescendsFrom(RTTI::IdType typeId, RTTI::IdType ancestorId)
+    {
+        for (auto it = m_types.Find(typeId); it != m_types.end(); it = m_types.Find(it->second.m_parentType))
+        {
+            if (it->first == ancestorId)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool TypeManager::NeedsRebuild(RTTI::IdType typeId)
+    {
+        for (auto it = m_types.Find(typeId); it != m_types.end(); it = m_types.Find(it->second.m_parentType))
+        {
+            if (it->second.m_isStale)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void TypeManager::FlattenSignatures(RTTI::IdType typeId, TypeLayout& layout)
+    {
+        auto it = m_types.Find(typeId);
+        if (it == m_types.end())
+        {
+            return;
+        }
+
+        // Inherited members come first, then our own
+        FlattenSignatures(it->second.m_parentType, layout);
+
+        // A runtime signature's name may go away with its type, so the layout keeps its own copy
+        for (const Signature& signature : it->second.m_signatures)
+        {
+            layout.m_runtimeNames.PushBack(signature.m_name);
+            layout.m_signatures.PushBack(StaticSignature{ layout.m_runtimeNames.Back(), signature.m_type, signature.m_size, signature.m_storageOffset });
+        }
+
+        for (const StaticSignature& signature : it->second.m_staticSignatures)
+        {
+            layout.m_signatures.PushBack(signature);
+        }
+    }
+
+    TypeManager::TypeInfo* TypeManager::InsertType(RTTI::IdType typeId, RTTI::IdType parentType)
+    {
+        if (typeId == parentType)
+        {
+            throw std::exception("Trying to add a type whose parent type is itself!");
+        }
+
+        auto [it, wasInserted] = m_types.Insert(std::make_pair(typeId, TypeInfo()));
+
+        if (!wasInserted)
+        {
+            return nullptr;
+        }
+
+        it->second.m_parentType = parentType;
+        m_isDirty.store(true, std::memory_order_release);
+
+        return &it->second;
     }
 }
\ No newline at end of file
@@ -1,11 +1,20 @@
 #pragma once
 #include "Datum.h"
 #include "HashMap.h"
+#include "ReadEpoch.h"
 #include "RTTI.h"
+#include "Scope.h"
+#include "SList.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <gsl/gsl>
 
 namespace FieaGameEngine
 {
-	#define RegisterType(Type, ParentType) (TypeManager::AddType(Type::TypeIdClass(), Type::Signatures(), ParentType::TypeIdClass()));
+	#define RegisterType(Type, ParentType) (TypeManager::AddType<Type, ParentType>());
 
 	/// <summary>
 	/// Signature struct that holds the data needed to construct a key, Datum pair for a particular
@@ -81,19 +90,89 @@ namespace FieaGameEngine
 	};
 
 	/// <summary>
-	/// TypeManager static class that handles maintaining a map of types and their signatures
+	/// StaticSignature struct that describes an attribute entirely at compile time. Types return a
+	/// constexpr std::array of these from Signatures() so that their layout is validated while
+	/// compiling and can be registered without copying any names.
+	/// </summary>
+	struct StaticSignature final
+	{
+		/// <summary>
+		/// The name of the attribute
+		/// </summary>
+		std::string_view m_name;
+
+		/// <summary>
+		/// The type of the attribute
+		/// </summary>
+		Datum::DatumType m_type;
+
+		/// <summary>
+		/// The size of the attribute
+		/// </summary>
+		size_t m_size;
+
+		/// <summary>
+		/// The offset (in bytes) of the attribute from the base class address. Taken with
+		/// offsetof, which is only conditionally supported for types that aren't standard layout.
+		/// </summary>
+		size_t m_storageOffset;
+	};
+
+	/// <summary>
+	/// TypeLayout struct that holds the flattened, inheritance resolved attribute layout of a
+	/// type. A layout is built by the TypeManager when its type, or one of its ancestors, is
+	/// registered or unregistered, and is handed out by const reference, so reading one never
+	/// allocates. A layout is never changed once built.
+	/// </summary>
+	struct TypeLayout final
+	{
+		/// <summary>
+		/// Every signature of the type, starting with the signatures of its furthest ancestor.
+		/// Compile time signatures are used as is, so their names still view the static tables.
+		/// </summary>
+		Vector<StaticSignature> m_signatures;
+
+		/// <summary>
+		/// Copies of the names of runtime registered signatures, which those signatures view.
+		/// A list, so that adding a name never moves the ones before it.
+		/// </summary>
+		SList<std::string> m_runtimeNames;
+
+		/// <summary>
+		/// The number of prescribed attributes an instance of this type has, which is every
+		/// signature plus the "this" attribute
+		/// </summary>
+		size_t m_prescribedCount = 1;
+
+		/// <summary>
+		/// Preformatted attribute table that instances of the type are copied from. It holds
+		/// "this" followed by every signature in layout order. External storage Datums hold
+		/// their storage offset in place of a pointer, so the prototype must never be read
+		/// directly; Attributed binds them to each new instance as it is constructed.
+		/// </summary>
+		Scope m_prototype;
+	};
+
+	/// <summary>
+	/// TypeManager static class that handles maintaining a map of types and their signatures.
+	/// Registration is serialized by a mutex, while lookups read an immutable, published
+	/// snapshot without locking, so Attributed objects can be constructed on any thread.
 	/// </summary>
 	class TypeManager final
 	{
 	public:
 		/// <summary>
-		/// TypeInfo struct that serves as a wrapper for two pieces of information on a type:
-		/// the Vector of signatures and the parent type ID
+		/// TypeInfo struct that serves as a wrapper for the information on a type: the signatures
+		/// it declares itself (either a runtime Vector or a view of a compile time table), the 
+		/// parent type ID, its flattened layout and whether that layout has to be rebuilt
 		/// </summary>
 		struct TypeInfo
 		{
 			Vector<Signature> m_signatures;
+			gsl::span<const StaticSignature> m_staticSignatures;
 			RTTI::IdType m_parentType;
+			gsl::owner<TypeLayout*> m_layout = nullptr;
+			bool m_isStale = true;
 		};
 
 		TypeManager() = delete;
@@ -104,13 +183,24 @@ namespace FieaGameEngine
 		~TypeManager() = default;
 		
 		/// <summary>
-		/// Static method to retrieve a list of Signatures for the given type
+		/// Static method to retrieve a list of Signatures for the given type, including all
+		/// inherited Signatures
 		/// </summary>
 		/// <param name="typeId"> The typeId to get the Signatures for </param>
-        /// <returns> A Vector of Signatures corresponding to the typeId </returns>
+        /// <returns> A reference to the cached Vector of Signatures corresponding to the typeId,
+        /// valid for as long as the layout of the type is </returns>
+        /// <exception cref="std::runtime_error"> Throws if the passed in typeId does
+        /// not correspond to a type that is registered with the TypeManager </exception>
+		static const Vector<StaticSignature>& GetSignatures(RTTI::IdType typeId);
+
+		/// <summary>
+		/// Static method to retrieve the flattened layout of the given type
+		/// </summary>
+		/// <param name="typeId"> The typeId to get the layout for </param>
+        /// <returns> A reference to the cached layout corresponding to the typeId </returns>
         /// <exception cref="std::runtime_error"> Throws if the passed in typeId does
         /// not correspond to a type that is registered with the TypeManager </exception>
-		static const Vector<Signature> GetSignatures(RTTI::IdType typeId);
+		static const TypeLayout& GetLayout(RTTI::IdType typeId);
 
         /// <summary>
         /// Static method to check if the passed in type has been registered
@@ -133,6 +223,65 @@ namespace FieaGameEngine
         /// pass itself as the parent </exception>
 		static bool AddType(RTTI::IdType typeId, const Vector<Signature>& signatures, RTTI::IdType parentType);
 
+        /// <summary>
+        /// Static method to register a type whose signatures are a compile time table. The table
+        /// must have static storage duration since only a view of it is kept.
+        /// </summary>
+        /// <param name="typeId"> The typeId of the type you are registering </param>
+        /// <param name="signatures"> The compile time Signature table of the type you are registering </param>
+        /// <param name="parentType"> The typeId of the parent of the type you are
+        /// registering </param>
+        /// <returns> True if the type was registered, false if it had already been
+        /// registered </returns>
+        /// <exception cref="std::runtime_error"> Throws if you try to register a type and
+        /// pass itself as the parent </exception>
+		static bool AddType(RTTI::IdType typeId, gsl::span<const StaticSignature> signatures, RTTI::IdType parentType);
+
+        /// <summary>
+        /// Static method to register T as a child of ParentT using T::Signatures(). If that returns
+        /// a constexpr std::array of StaticSignatures, the table is validated at compile time and
+        /// registered without copying it. Otherwise the returned Vector of Signatures is copied.
+        /// </summary>
+        /// <typeparam name="T"> The type to register </typeparam>
+        /// <typeparam name="ParentT"> The parent of the type to register </typeparam>
+        /// <returns> True if the type was registered, false if it had already been registered </returns>
+		template <typename T, typename ParentT>
+		static bool AddType();
+
+		#pragma region Compile Time Validation
+		/// <summary>
+		/// Gets the size in bytes of one element of the given DatumType
+		/// </summary>
+		/// <param name="type"> The DatumType to get the size of </param>
+		/// <returns> The size of one element, 0 for Unknown </returns>
+		static constexpr size_t DatumTypeSize(Datum::DatumType type);
+
+		/// <summary>
+		/// Checks that every non-Table signature in the table lies entirely inside of T
+		/// </summary>
+		/// <param name="signatures"> The table to check </param>
+		/// <returns> True if every offset is in range </returns>
+		template <typename T, size_t N>
+		static constexpr bool OffsetsInRange(const std::array<StaticSignature, N>& signatures);
+
+		/// <summary>
+		/// Checks that no two signatures in the table share a name
+		/// </summary>
+		/// <param name="signatures"> The table to check </param>
+		/// <returns> True if every name is unique </returns>
+		template <size_t N>
+		static constexpr bool NamesAreUnique(const std::array<StaticSignature, N>& signatures);
+
+		/// <summary>
+		/// Checks that every Table signature in the table has a size and offset of 0 and that no
+		/// signature has an Unknown type
+		/// </summary>
+		/// <param name="signatures"> The table to check </param>
+		/// <returns> True if every Table signature is empty </returns>
+		template <size_t N>
+		static constexpr bool TablesAreEmpty(const std::array<StaticSignature, N>& signatures);
+		#pragma endregion
+
 		/// <summary>
 		/// Static method that attempts to unregister a type with the TypeManager. 
 		/// </summary>
@@ -142,7 +291,18 @@ namespace FieaGameEngine
 		static bool RemoveType(RTTI::IdType typeId);
 
 		/// <summary>
-		/// Static method that unregisters all types with the TypeManager
+		/// Static method that publishes every registration made so far as an immutable snapshot.
+		/// Call it at the end of startup registration so the first lookup doesn't have to.
+		/// Registering a type after this publishes a fresh snapshot on the next lookup, leaving
+		/// the ones other threads are reading untouched. Only the layouts of the types that
+		/// changed and their descendants are rebuilt.
+		/// </summary>
+		static void Publish();
+
+		/// <summary>
+		/// Static method that unregisters all types with the TypeManager. Unlike every other
+		/// method this is not safe to call while other threads are looking types up or while
+		/// any Attributed object is alive, since it frees every snapshot and layout.
 		/// </summary>
 		static void Clear();
 
@@ -152,12 +312,109 @@ namespace FieaGameEngine
 		static size_t Size();
 
 	private:
+		using TypeMap = HashMap<RTTI::IdType, TypeInfo>;
+		using LayoutMap = HashMap<RTTI::IdType, const TypeLayout*>;
+
+		/// <summary>
+		/// A snapshot replaced by a later publish, with the epoch it was retired in
+		/// </summary>
+		struct RetiredSnapshot final
+		{
+			const LayoutMap* m_layouts;
+			std::uint64_t m_tag;
+		};
+
+		/// <summary>
+		/// Gets the published snapshot of the registry, publishing a new one first if a type was
+		/// added or removed since the last publish. Once published, lookups take no locks. Must
+		/// be called while a ReadEpoch::Guard is alive, and the snapshot must not be used after
+		/// the guard ends; the layouts it points to may be.
+		/// </summary>
+		/// <returns> The current snapshot </returns>
+		static const LayoutMap& Snapshot();
+
+		/// <summary>
+		/// Rebuilds the stale layouts and publishes a new snapshot that points to every current
+		/// layout. The previous snapshot is retired rather than deleted, since readers on other
+		/// threads may still be reading it, and each retired snapshot is deleted by the first
+		/// publish after every reader that could have seen it has finished. Must be called with
+		/// m_mutex held.
+		/// </summary>
+		static void PublishLocked();
+
+		/// <summary>
+		/// Rebuilds the layout of every type that is stale or has a stale ancestor. Replaced
+		/// layouts are kept until Clear, since Attributed objects point to the layout they were
+		/// built from.
+		/// </summary>
+		static void RebuildStaleLayouts();
+
+		/// <summary>
+		/// Checks whether a type is the given ancestor or derives from it, through registered types
+		/// </summary>
+		/// <param name="typeId"> The type to check </param>
+		/// <param name="ancestorId"> The ancestor to look for </param>
+		/// <returns> True if ancestorId is typeId or one of its registered ancestors </returns>
+		static bool DescendsFrom(RTTI::IdType typeId, RTTI::IdType ancestorId);
+
+		/// <summary>
+		/// Checks whether a type or any of its registered ancestors is stale
+		/// </summary>
+		/// <param name="typeId"> The type to check </param>
+		/// <returns> True if its layout has to be rebuilt </returns>
+		static bool NeedsRebuild(RTTI::IdType typeId);
+
+		/// <summary>
+		/// Appends the signatures of the given type, preceded by those of its ancestors, to the
+		/// passed in layout. Compile time tables are appended without copying their names.
+		/// </summary>
+		/// <param name="typeId"> The type to flatten </param>
+		/// <param name="layout"> The layout to append to </param>
+		static void FlattenSignatures(RTTI::IdType typeId, TypeLayout& layout);
+
+		/// <summary>
+		/// Helper that inserts a new TypeInfo and marks the registry as needing a publish. Must be
+		/// called with m_mutex held.
+		/// </summary>
+		/// <param name="typeId"> The typeId of the type being registered </param>
+		/// <param name="parentType"> The typeId of its parent </param>
+		/// <returns> A pointer to the new TypeInfo, or nullptr if the type was already registered </returns>
+		static TypeInfo* InsertType(RTTI::IdType typeId, RTTI::IdType parentType);
+
+		/// <summary>
+		/// Serializes registration and publishing
+		/// </summary>
+		static std::mutex m_mutex;
+
+		/// <summary>
+		/// Whether a type was added or removed since the last publish. Registration only marks
+		/// the registry dirty, so registering many types at startup publishes once.
+		/// </summary>
+		static std::atomic<bool> m_isDirty;
+
+		/// <summary>
+		/// The immutable snapshot every lookup reads from, nullptr until the first publish
+		/// </summary>
+		static std::atomic<const LayoutMap*> m_published;
+
+		/// <summary>
+		/// Snapshots replaced by a later publish, kept alive until no lookup can still hold them.
+		/// Only touched with m_mutex held.
+		/// </summary>
+		static Vector<RetiredSnapshot> m_retired;
+
+		/// <summary>
+		/// Layouts replaced by a rebuild or left by an unregistered type. They are kept alive
+		/// until Clear so that references handed out to them stay valid.
+		/// </summary>
+		static Vector<gsl::owner<TypeLayout*>> m_retiredLayouts;
 
 		/// <summary>
-		/// Internal hashmap that keeps track of all registered types and their associated
-		/// info
+		/// Internal hashmap that registration writes to. Only touched with m_mutex held; readers
+		/// go through the published snapshot instead.
 		/// </summary>
-		static HashMap<RTTI::IdType, TypeInfo> m_types;
+		static TypeMap m_types;
 	};
 }
 
+#include "TypeManager.inl"
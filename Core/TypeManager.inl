@@ -0,0 +1,119 @@
+#pragma once
+#include "TypeManager.h"
+
+namespace FieaGameEngine
+{
+    /// <summary>
+    /// Trait that detects whether a Signatures() return type is a compile time table
+    /// </summary>
+    template <typename T>
+    struct IsStaticSignatureTable : std::false_type {};
+
+    template <size_t N>
+    struct IsStaticSignatureTable<std::array<StaticSignature, N>> : std::true_type {};
+
+    template<typename T, typename ParentT>
+    inline bool TypeManager::AddType()
+    {
+        using SignaturesType = std::remove_cv_t<decltype(T::Signatures())>;
+
+        if constexpr (IsStaticSignatureTable<SignaturesType>::value)
+        {
+            // The table lives for the whole program, so TypeManager only has to keep a view of it
+            static constexpr SignaturesType signatures = T::Signatures();
+
+            static_assert(OffsetsInRange<T>(signatures), "A signature's storage lies outside of the registered type!");
+            static_assert(NamesAreUnique(signatures), "Two signatures of the registered type share a name!");
+            static_assert(TablesAreEmpty(signatures), "Table signatures must have a size and offset of 0, and no signature may be Unknown!");
+
+            return AddType(T::TypeIdClass(), gsl::span<const StaticSignature>(signatures.data(), signatures.size()), ParentT::TypeIdClass());
+        }
+        else
+        {
+            return AddType(T::TypeIdClass(), T::Signatures(), ParentT::TypeIdClass());
+        }
+    }
+
+    inline constexpr size_t TypeManager::DatumTypeSize(Datum::DatumType type)
+    {
+        switch (type)
+        {
+        case Datum::DatumType::Integer:
+            return sizeof(int);
+        case Datum::DatumType::String:
+            return sizeof(std::string);
+        case Datum::DatumType::Float:
+            return sizeof(float);
+        case Datum::DatumType::Vector:
+            return sizeof(glm::vec4);
+        case Datum::DatumType::Matrix:
+            return sizeof(glm::mat4);
+        case Datum::DatumType::RTTI:
+            return sizeof(RTTI*);
+        case Datum::DatumType::Table:
+            return sizeof(Scope*);
+        default:
+            return 0;
+        }
+    }
+
+    template<typename T, size_t N>
+    inline constexpr bool TypeManager::OffsetsInRange(const std::array<StaticSignature, N>& signatures)
+    {
+        for (const StaticSignature& signature : signatures)
+        {
+            if (signature.m_type == Datum::DatumType::Table)
+            {
+                continue;
+            }
+
+            if (signature.m_storageOffset + (signature.m_size * DatumTypeSize(signature.m_type)) > sizeof(T))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<size_t N>
+    inline constexpr bool TypeManager::NamesAreUnique(const std::array<StaticSignature, N>& signatures)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (signatures[i].m_name.empty() || signatures[i].m_name == "this")
+            {
+                return false;
+            }
+
+            for (size_t j = i + 1; j < N; ++j)
+            {
+                if (signatures[i].m_name == signatures[j].m_name)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template<size_t N>
+    inline constexpr bool TypeManager::TablesAreEmpty(const std::array<StaticSignature, N>& signatures)
+    {
+        for (const StaticSignature& signature : signatures)
+        {
+            if (signature.m_type == Datum::DatumType::Unknown)
+            {
+                return false;
+            }
+
+            if (signature.m_type == Datum::DatumType::Table && (signature.m_size != 0 || signature.m_storageOffset != 0))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
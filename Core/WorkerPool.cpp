@@ -0,0 +1,115 @@
+#include "pch.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace FieaGameEngine
+{
+    WorkerPool::WorkerPool(size_t workerCount)
+    {
+        if (workerCount == 0)
+        {
+            workerCount = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+        }
+
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_runStarted.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void WorkerPool::Run(size_t taskCount, const Task& task)
+    {
+        if (taskCount == 0)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_taskCount = taskCount;
+            m_nextTask.store(0, std::memory_order_relaxed);
+            m_busyWorkers = m_workers.size();
+            m_failure = nullptr;
+            ++m_run;
+        }
+        m_runStarted.notify_all();
+
+        RunTasks();
+
+        std::exception_ptr failure;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_runFinished.wait(lock, [this]() { return m_busyWorkers == 0; });
+            m_task = nullptr;
+            failure = std::exchange(m_failure, nullptr);
+        }
+
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    void WorkerPool::WorkerLoop()
+    {
+        std::uint64_t lastRun = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_runStarted.wait(lock, [this, lastRun]() { return m_isStopping || m_run != lastRun; });
+                if (m_isStopping)
+                {
+                    return;
+                }
+
+                lastRun = m_run;
+            }
+
+            RunTasks();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0)
+            {
+                m_runFinished.notify_one();
+            }
+        }
+    }
+
+    void WorkerPool::RunTasks()
+    {
+        for (size_t i = m_nextTask.fetch_add(1, std::memory_order_relaxed); i < m_taskCount; i = m_nextTask.fetch_add(1, std::memory_order_relaxed))
+        {
+            try
+            {
+                (*m_task)(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_failure)
+                {
+                    m_failure = std::current_exception();
+                }
+            }
+        }
+    }
+}
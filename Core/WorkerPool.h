@@ -0,0 +1,126 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FieaGameEngine
+{
+    /// <summary>
+    /// Fixed set of worker threads that are started once and then reused, so handing out work
+    /// costs a wake-up instead of a thread per task. Work is handed out in runs: every task
+    /// index of a run is claimed with one atomic increment by whichever thread is free, the
+    /// calling thread included, and the run returns once all of them have finished.
+    /// </summary>
+    class WorkerPool final
+    {
+    public:
+        /// <summary>
+        /// Work done by a run, called once for every task index
+        /// </summary>
+        using Task = std::function<void(size_t taskIndex)>;
+
+        /// <summary>
+        /// Constructor that starts the workers
+        /// </summary>
+        /// <param name="workerCount"> How many threads to start. Zero starts one less than the
+        /// number of hardware threads, since the calling thread works too. </param>
+        explicit WorkerPool(size_t workerCount = 0);
+
+        WorkerPool(const WorkerPool& other) = delete;
+        WorkerPool& operator=(const WorkerPool& other) = delete;
+        WorkerPool(WorkerPool&& other) = delete;
+        WorkerPool& operator=(WorkerPool&& other) = delete;
+
+        /// <summary>
+        /// Destructor that stops and joins the workers. Must not be called during a run.
+        /// </summary>
+        ~WorkerPool();
+
+        /// <summary>
+        /// Gets how many threads a run is spread over, including the calling thread
+        /// </summary>
+        /// <returns> The number of threads that work on a run </returns>
+        size_t ThreadCount() const { return m_workers.size() + 1; }
+
+        /// <summary>
+        /// Calls task once for every index in [0, taskCount) across the workers and the calling
+        /// thread, and returns once every call has finished. Only one thread may run at a time.
+        /// </summary>
+        /// <param name="taskCount"> How many task indices to run </param>
+        /// <param name="task"> The work to do for each index </param>
+        /// <exception cref="std::exception"> Rethrows the first exception a task threw, after
+        /// every task has finished </exception>
+        void Run(size_t taskCount, const Task& task);
+
+    private:
+        /// <summary>
+        /// Body of each worker thread, which sleeps until a run starts or the pool stops
+        /// </summary>
+        void WorkerLoop();
+
+        /// <summary>
+        /// Claims and runs task indices of the current run until there are none left
+        /// </summary>
+        void RunTasks();
+
+        /// <summary>
+        /// The worker threads
+        /// </summary>
+        std::vector<std::thread> m_workers;
+
+        /// <summary>
+        /// Guards everything below except m_nextTask
+        /// </summary>
+        std::mutex m_mutex;
+
+        /// <summary>
+        /// Wakes the workers when a run starts or the pool stops
+        /// </summary>
+        std::condition_variable m_runStarted;
+
+        /// <summary>
+        /// Wakes the calling thread when the last worker finishes a run
+        /// </summary>
+        std::condition_variable m_runFinished;
+
+        /// <summary>
+        /// The work of the current run
+        /// </summary>
+        const Task* m_task = nullptr;
+
+        /// <summary>
+        /// How many task indices the current run has
+        /// </summary>
+        size_t m_taskCount = 0;
+
+        /// <summary>
+        /// The next task index to claim
+        /// </summary>
+        std::atomic<size_t> m_nextTask{ 0 };
+
+        /// <summary>
+        /// Workers that haven't finished the current run yet
+        /// </summary>
+        size_t m_busyWorkers = 0;
+
+        /// <summary>
+        /// Incremented for every run, so each worker joins each run exactly once
+        /// </summary>
+        std::uint64_t m_run = 0;
+
+        /// <summary>
+        /// The first exception thrown by a task of the current run
+        /// </summary>
+        std::exception_ptr m_failure;
+
+        /// <summary>
+        /// Whether the workers should exit
+        /// </summary>
+        bool m_isStopping = false;
+    };
+}
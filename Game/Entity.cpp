@@ -19,24 +19,6 @@ namespace FieaGameEngine
     {
     }
 
-    const Vector<Signature> Entity::Signatures()
-    {
-        return Vector<Signature>
-        {
-            { "Name", Datum::DatumType::String, 1, offsetof(Entity, m_name) },
-            { "Tag", Datum::DatumType::String, 1, offsetof(Entity, m_tag) },
-            { "Texture", Datum::DatumType::String, 1, offsetof(Entity, m_textureFileName) },
-            { "Position", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_position) },
-            { "Rotation", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_rotation) },
-            { "Scale", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_scale) },
-            { "Children", Datum::DatumType::Table, 0, 0 },
-            { "Actions", Datum::DatumType::Table, 0, 0 },
-            { "Animations", Datum::DatumType::Table, 0, 0 },
-            { "HasRelativePosition", Datum::DatumType::Integer, 1, offsetof(Entity, m_UseRelativePosition)},
-            { "HasRelativeFacing", Datum::DatumType::Integer, 1, offsetof(Entity, m_UseRelativeFacing) }
-        };
-    }
-
     void Entity::SetTextureFile(std::string textureFile)
     {
         if (!textureFile.empty())
@@ -71,16 +53,26 @@ namespace FieaGameEngine
         for (size_t i = 0; i < children.Size(); ++i)
         {
             Scope* scopeChild = &children.Get<Scope>(i);
-            assert(scopeChild->Is(Entity::TypeIdClass()));
+            assert(scopeChild->Is<Entity>());
             Entity& child = static_cast<Entity&>(*scopeChild);
             child.Init(worldState);
         }
 
+        // Init all actions
+        Datum& actions = Actions();
+        for (size_t i = 0; i < actions.Size(); ++i)
+        {
+            Scope* scopeChild = &actions.Get<Scope>(i);
+            assert(scopeChild->Is<Action>());
+            Action& child = static_cast<Action&>(*scopeChild);
+            child.Init(worldState);
+        }
+
         Datum& animations = Animations();
         for (size_t i = 0; i < animations.Size(); ++i)
         {
             Scope* animation = &animations.Get<Scope>(i);
-            assert(animation->Is(Animation::TypeIdClass()));
+            assert(animation->Is<Animation>());
             Animation& child = static_cast<Animation&>(*animation);
             
             m_Animations[child.GetStateName()] = &child;
@@ -100,26 +92,38 @@ namespace FieaGameEngine
         for (size_t i = 0; i < children.Size(); ++i)
         {
             Scope* scopeChild = &children.Get<Scope>(i);
-            assert(scopeChild->Is(Entity::TypeIdClass()));
+            assert(scopeChild->Is<Entity>());
             Entity& child = static_cast<Entity&>(*scopeChild);
             child.Update(worldState);
         }
 
         Datum& actions = Actions();
 
-        for (size_t i = 0; i < actions.Size(); ++i)
+        if (m_usesCompiledActions)
         {
-            Scope* scopeChild = &actions.Get<Scope>(i);
-            assert(scopeChild->Is(Action::TypeIdClass()));
-            Action& child = static_cast<Action&>(*scopeChild);
-            child.Update(worldState);
+            if (!m_actionProgram.IsCompiled())
+            {
+                m_actionProgram.Compile(actions);
+            }
+
+            m_actionProgram.Run(worldState);
+        }
+        else
+        {
+            for (size_t i = 0; i < actions.Size(); ++i)
+            {
+                Scope* scopeChild = &actions.Get<Scope>(i);
+                assert(scopeChild->Is<Action>());
+                Action& child = static_cast<Action&>(*scopeChild);
+                child.Update(worldState);
+            }
         }
 
         Datum& animations = Animations();
         for (size_t i = 0; i < animations.Size(); ++i)
         {
             Scope* scopeChild = &animations.Get<Scope>(i);
-            assert(scopeChild->Is(Animation::TypeIdClass()));
+            assert(scopeChild->Is<Animation>());
             Animation& child = static_cast<Animation&>(*scopeChild);
             child.Update();
         }
@@ -142,7 +146,7 @@ namespace FieaGameEngine
         for (size_t i = 0; i < children.Size(); ++i)
         {
             Scope* scopeChild = &children.Get<Scope>(i);
-            assert(scopeChild->Is(Entity::TypeIdClass()));
+            assert(scopeChild->Is<Entity>());
             Entity& child = static_cast<Entity&>(*scopeChild);
             child.Render(worldState);
         }
@@ -174,6 +178,19 @@ namespace FieaGameEngine
         return actionPtr;
     }
 
+    void Entity::InvalidateActionProgram(Scope& scope)
+    {
+        for (Scope* current = &scope; current != nullptr; current = current->GetParent())
+        {
+            Entity* entity = current->As<Entity>();
+            if (entity != nullptr)
+            {
+                entity->InvalidateActionProgram();
+                return;
+            }
+        }
+    }
+
     std::string Entity::GetCurrentAnimationState() const
     {
         if (m_CurrentAnimation)
@@ -4,6 +4,8 @@
 #include "Factory.h"
 #include "RenderUtil.h"
 #include "HashMap.h"
+#include "ActionProgram.h"
+#include "ActionNameIndex.h"
 #include <box2d/box2d.h>
 
 namespace FieaGameEngine
@@ -33,6 +35,7 @@ namespace FieaGameEngine
     /// </summary>
 	class Entity : public Attributed
 	{
+        POOL_DECLARATIONS(Entity);
         RTTI_DECLARATIONS(Entity, Attributed);
 
 	public:
@@ -80,15 +83,15 @@ namespace FieaGameEngine
         /// Gets the child entities of this Entity
         /// </summary>
         /// <returns> A datum containing the child entities </returns>
-        inline Datum& Children() { return m_order[m_childrenIndex]->second; };
+        inline Datum& Children() { return m_order[m_childrenIndex].second; };
 
         /// <summary>
         /// Gets the child actions of this Entity
         /// </summary>
         /// <returns> A datum containing the child actions </returns>
-        inline Datum& Actions() { return m_order[m_actionsIndex]->second; };
+        inline Datum& Actions() { return m_order[m_actionsIndex].second; };
 
-        inline Datum& Animations() { return m_order[m_animationsIndex]->second; }
+        inline Datum& Animations() { return m_order[m_animationsIndex].second; }
 
         inline const TextureInfo& GetTextureInfo() const { return m_textureInfo; };
 
@@ -133,9 +136,25 @@ namespace FieaGameEngine
         /// Retrieves the Signatures for this class, which describe its prescribed 
         /// attributes
         /// </summary>
-        /// <returns> A Vector of Signatures representing the prescribed attributes
+        /// <returns> A compile time table of Signatures representing the prescribed attributes
         /// of this class </returns>
-        static const Vector<Signature> Signatures();
+        static constexpr std::array<StaticSignature, 11> Signatures()
+        {
+            return std::array<StaticSignature, 11>
+            { {
+                { "Name", Datum::DatumType::String, 1, offsetof(Entity, m_name) },
+                { "Tag", Datum::DatumType::String, 1, offsetof(Entity, m_tag) },
+                { "Texture", Datum::DatumType::String, 1, offsetof(Entity, m_textureFileName) },
+                { "Position", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_position) },
+                { "Rotation", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_rotation) },
+                { "Scale", Datum::DatumType::Vector, 1, offsetof(Entity, m_transform.m_scale) },
+                { "Children", Datum::DatumType::Table, 0, 0 },
+                { "Actions", Datum::DatumType::Table, 0, 0 },
+                { "Animations", Datum::DatumType::Table, 0, 0 },
+                { "HasRelativePosition", Datum::DatumType::Integer, 1, offsetof(Entity, m_UseRelativePosition) },
+                { "HasRelativeFacing", Datum::DatumType::Integer, 1, offsetof(Entity, m_UseRelativeFacing) }
+            } };
+        }
 
         /// <summary>
         /// Sets the entity's texture
@@ -186,6 +205,39 @@ namespace FieaGameEngine
 
         Action* CreateAction(const std::string& className, const std::string& instanceName);
 
+        /// <summary>
+        /// Sets whether this Entity runs its actions through a compiled ActionProgram instead
+        /// of walking the action tree every update
+        /// </summary>
+        /// <param name="usesCompiledActions"> True to run the compiled program </param>
+        void SetUsesCompiledActions(bool usesCompiledActions) { m_usesCompiledActions = usesCompiledActions; }
+
+        /// <summary>
+        /// Checks whether this Entity runs its actions through a compiled ActionProgram
+        /// </summary>
+        /// <returns> True if it runs the compiled program, false otherwise </returns>
+        bool UsesCompiledActions() const { return m_usesCompiledActions; }
+
+        /// <summary>
+        /// Marks this Entity's compiled actions as stale so they are recompiled before the next
+        /// update. Actions call this on their owning Entity whenever they are adopted, orphaned,
+        /// moved or destroyed anywhere in its action tree, so it rarely needs calling by hand.
+        /// </summary>
+        void InvalidateActionProgram() { m_actionProgram.Invalidate(); }
+
+        /// <summary>
+        /// Gets the index of this Entity's actions by name
+        /// </summary>
+        /// <returns> The name index of this Entity's "Actions" </returns>
+        ActionNameIndex& ActionIndex() { return m_actionIndex; }
+
+        /// <summary>
+        /// Invalidates the compiled actions of the nearest Entity at or above a scope. Entities
+        /// that are being destroyed are no longer Entities, so they are passed over.
+        /// </summary>
+        /// <param name="scope"> The scope whose owning Entity to invalidate </param>
+        static void InvalidateActionProgram(Scope& scope);
+
 	protected:
         /// <summary>
         /// The name of this Entity
@@ -260,9 +312,22 @@ namespace FieaGameEngine
         /// </summary>
         Entity* m_EntityParent = nullptr;
 
-        
+        /// <summary>
+        /// This Entity's actions compiled into a flat program, rebuilt when it is invalidated
+        /// </summary>
+        ActionProgram m_actionProgram;
+
+        /// <summary>
+        /// Whether Update runs m_actionProgram instead of walking the action tree
+        /// </summary>
+        bool m_usesCompiledActions = false;
+
+        /// <summary>
+        /// This Entity's actions indexed by name, kept current by the actions themselves
+        /// </summary>
+        ActionNameIndex m_actionIndex{ m_actionsIndex };
 	};
 
-    ConcreteFactory(Entity, Scope);
+    PooledConcreteFactory(Entity, Scope);
 }
 
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "EventReplay.h"
+#include "EventMessageAttributed.h"
+#include "WorldState.h"
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace FieaGameEngine
+{
+    void EventRecording::Record(const EventPtr<EventPublisher>& event, high_resolution_clock::time_point enqueueTime, milliseconds delay)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_entries.IsEmpty())
+        {
+            m_origin = enqueueTime;
+        }
+
+        m_entries.PushBack(Entry{ event, duration_cast<milliseconds>(enqueueTime - m_origin), delay });
+    }
+
+    void EventRecording::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.Clear();
+    }
+
+    EventReplay::EventReplay(const EventRecording& recording, WorldState& worldState)
+        : m_recording(&recording), m_worldState(&worldState)
+    {
+        const Vector<EventRecording::Entry>& entries = recording.Entries();
+
+        m_order.Reserve(entries.Size());
+        for (size_t i = 0; i < entries.Size(); ++i)
+        {
+            m_order.PushBack(i);
+        }
+
+        // Producers on other threads may have recorded slightly out of order
+        if (!m_order.IsEmpty())
+        {
+            size_t* first = &m_order.Front();
+            std::stable_sort(first, first + m_order.Size(), [&entries](size_t lhs, size_t rhs)
+                {
+                    return entries[lhs].m_enqueueOffset < entries[rhs].m_enqueueOffset;
+                });
+        }
+    }
+
+    void EventReplay::Update()
+    {
+        auto currentTime = m_worldState->GetGameTime().CurrentTime();
+        if (!m_hasStarted)
+        {
+            m_startTime = currentTime;
+            m_hasStarted = true;
+        }
+
+        const Vector<EventRecording::Entry>& entries = m_recording->Entries();
+        EventQueue& eventQueue = m_worldState->GetEventQueue();
+
+        while (m_nextEntry < m_order.Size())
+        {
+            const EventRecording::Entry& entry = entries[m_order[m_nextEntry]];
+            if (m_startTime + entry.m_enqueueOffset > currentTime)
+            {
+                break;
+            }
+
+            eventQueue.Enqueue(Rebind(entry.m_event), entry.m_delay);
+            ++m_nextEntry;
+        }
+    }
+
+    size_t EventReplay::RunHeadless(const EventRecording& recording, WorldState& worldState, milliseconds frameTime, size_t maxFrames)
+    {
+        EventReplay replay(recording, worldState);
+        GameTime& gameTime = worldState.GetGameTime();
+
+        size_t frameCount = 0;
+        while (frameCount < maxFrames && (!replay.IsFinished() || !worldState.GetEventQueue().IsEmpty()))
+        {
+            replay.Update();
+            worldState.CompletePendingRequests();
+
+            gameTime.SetCurrentTime(gameTime.CurrentTime() + frameTime);
+            gameTime.SetTotalGameTime(gameTime.TotalGameTime() + frameTime);
+            gameTime.SetElapsedGameTime(frameTime);
+
+            ++frameCount;
+        }
+
+        return frameCount;
+    }
+
+    EventPtr<EventPublisher> EventReplay::Rebind(const EventPtr<EventPublisher>& event) const
+    {
+        const Event<EventMessageAttributed>* attributedEvent = event->As<Event<EventMessageAttributed>>();
+        if (attributedEvent == nullptr)
+        {
+            return event;
+        }
+
+        EventMessageAttributed message = attributedEvent->Message();
+        message.SetWorldState(*m_worldState);
+        return MakeEvent<EventMessageAttributed>(std::move(message));
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include "Event.h"
+#include "Vector.h"
+
+namespace FieaGameEngine
+{
+    class WorldState;
+
+    /// <summary>
+    /// A recorded stream of enqueued events. Hand one to EventQueue::SetRecording and every
+    /// event enqueued from then on is kept, along with when it was enqueued and its delay.
+    /// Events are immutable once enqueued, so the recording simply shares them with the queue.
+    /// </summary>
+    class EventRecording final
+    {
+    public:
+        /// <summary>
+        /// One recorded event
+        /// </summary>
+        struct Entry
+        {
+            /// <summary>
+            /// The event that was enqueued
+            /// </summary>
+            EventPtr<EventPublisher> m_event;
+
+            /// <summary>
+            /// Game time between the first recorded enqueue and this one
+            /// </summary>
+            std::chrono::milliseconds m_enqueueOffset;
+
+            /// <summary>
+            /// The delay the event was enqueued with
+            /// </summary>
+            std::chrono::milliseconds m_delay;
+        };
+
+        EventRecording() = default;
+        EventRecording(const EventRecording&) = delete;
+        EventRecording& operator=(const EventRecording&) = delete;
+        ~EventRecording() = default;
+
+        /// <summary>
+        /// Adds an enqueued event to the recording. Called by EventQueue, from any thread that
+        /// enqueues.
+        /// </summary>
+        /// <param name="event"> The event being enqueued </param>
+        /// <param name="enqueueTime"> The game time it was enqueued at </param>
+        /// <param name="delay"> The delay it was enqueued with </param>
+        void Record(const EventPtr<EventPublisher>& event, std::chrono::high_resolution_clock::time_point enqueueTime, std::chrono::milliseconds delay);
+
+        /// <summary>
+        /// Gets the recorded events, in the order they were recorded
+        /// </summary>
+        /// <returns> The recorded events </returns>
+        const Vector<Entry>& Entries() const { return m_entries; }
+
+        /// <summary>
+        /// Removes every recorded event and restarts the clock at the next one
+        /// </summary>
+        void Clear();
+
+    private:
+        /// <summary>
+        /// The recorded events
+        /// </summary>
+        Vector<Entry> m_entries;
+
+        /// <summary>
+        /// The game time of the first recorded enqueue
+        /// </summary>
+        std::chrono::high_resolution_clock::time_point m_origin;
+
+        /// <summary>
+        /// Guards the entries, since producers on other threads record too
+        /// </summary>
+        std::mutex m_mutex;
+    };
+
+    /// <summary>
+    /// Re-injects a recorded event stream into a WorldState's EventQueue at the same game time
+    /// offsets it was recorded at. Used to reproduce reaction-heavy scenes without input, for
+    /// instance in a headless WorldState driven by RunHeadless.
+    /// </summary>
+    class EventReplay final
+    {
+    public:
+        /// <summary>
+        /// Constructor that prepares the recording for replay into the given WorldState. Events
+        /// are injected in order of when they were enqueued, ties broken by recording order.
+        /// </summary>
+        /// <param name="recording"> The recording to replay, which must outlive the replay </param>
+        /// <param name="worldState"> The WorldState to replay into </param>
+        EventReplay(const EventRecording& recording, WorldState& worldState);
+
+        EventReplay(const EventReplay&) = delete;
+        EventReplay& operator=(const EventReplay&) = delete;
+        ~EventReplay() = default;
+
+        /// <summary>
+        /// Enqueues every recorded event whose offset has passed since the first call to Update.
+        /// Call this once per frame before updating the EventQueue.
+        /// </summary>
+        void Update();
+
+        /// <summary>
+        /// Checks whether every recorded event has been injected
+        /// </summary>
+        /// <returns> True if the replay is done, false otherwise </returns>
+        bool IsFinished() const { return m_nextEntry == m_order.Size(); }
+
+        /// <summary>
+        /// Replays a recording into a WorldState with no window or input, advancing its game time
+        /// by a fixed step each frame until every event has been injected and delivered
+        /// </summary>
+        /// <param name="recording"> The recording to replay </param>
+        /// <param name="worldState"> The WorldState to replay into </param>
+        /// <param name="frameTime"> The game time each frame advances by </param>
+        /// <param name="maxFrames"> Stops after this many frames, in case reactions keep firing events </param>
+        /// <returns> The number of frames that were run </returns>
+        static size_t RunHeadless(const EventRecording& recording, WorldState& worldState, std::chrono::milliseconds frameTime, size_t maxFrames = SIZE_MAX);
+
+    private:
+        /// <summary>
+        /// Makes the event to inject for a recorded one. Attributed messages are copied and pointed
+        /// at our WorldState, everything else is shared as is.
+        /// </summary>
+        /// <param name="event"> The recorded event </param>
+        /// <returns> The event to enqueue </returns>
+        EventPtr<EventPublisher> Rebind(const EventPtr<EventPublisher>& event) const;
+
+        /// <summary>
+        /// The recording being replayed
+        /// </summary>
+        const EventRecording* m_recording;
+
+        /// <summary>
+        /// The WorldState being replayed into
+        /// </summary>
+        WorldState* m_worldState;
+
+        /// <summary>
+        /// Indices of the recorded entries, sorted by enqueue offset
+        /// </summary>
+        Vector<size_t> m_order;
+
+        /// <summary>
+        /// The next entry in m_order to inject
+        /// </summary>
+        size_t m_nextEntry = 0;
+
+        /// <summary>
+        /// Whether the replay clock has started
+        /// </summary>
+        bool m_hasStarted = false;
+
+        /// <summary>
+        /// The game time of the first call to Update
+        /// </summary>
+        std::chrono::high_resolution_clock::time_point m_startTime;
+    };
+}
@@ -63,6 +63,12 @@ namespace FieaGameEngine
 
     void Game::LoadWorldFromJSON(const std::string& filename)
     {
+        // Every factory is registered by the time a world loads, so lock in the perfect hash
+        if (!Factory<Scope>::IsFrozen())
+        {
+            Factory<Scope>::Freeze();
+        }
+
         JsonTableParseHelper tableHelper;
         JsonTableParseHelper::SharedData sharedData(m_rootEntity);
         JsonParseCoordinator jpc(sharedData);
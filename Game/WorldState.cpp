@@ -5,6 +5,7 @@
 #include "Game.h"
 #include "JsonParseCoordinator.h"
 #include "JsonTableParseHelper.h"
+#include "ReactionAttributed.h"
 
 using namespace std::chrono;
 
@@ -13,10 +14,18 @@ namespace FieaGameEngine
     WorldState::WorldState()
     {
         m_eventQueue = new EventQueue(m_gameTime);
+
+        // Attributed reactions share one subscriber that must join on this thread, not wherever they're built
+        ReactionAttributed::SubscribeDispatcher();
     }
 
     WorldState::~WorldState()
     {
+        while (!m_scopeStack.IsEmpty())
+        {
+            PopScope();
+        }
+
         delete m_eventQueue;
     }
 
@@ -39,6 +48,45 @@ namespace FieaGameEngine
         m_destroyActionRequests.Clear();
     }
 
+    void WorldState::PushScope(const Scope& scope)
+    {
+        m_scopeStack.Push(ScopeFrame(scope));
+    }
+
+    void WorldState::PopScope()
+    {
+        delete m_scopeStack.Top().m_copy;
+        m_scopeStack.Pop();
+    }
+
+    const Scope* WorldState::TopScope() const
+    {
+        if (m_scopeStack.IsEmpty())
+        {
+            return nullptr;
+        }
+
+        const ScopeFrame& frame = m_scopeStack.Top();
+        return (frame.m_copy != nullptr) ? frame.m_copy : frame.m_scope;
+    }
+
+    Scope& WorldState::MutableTopScope()
+    {
+        if (m_scopeStack.IsEmpty())
+        {
+            throw std::exception("Trying to write to the top of an empty scope stack!");
+        }
+
+        // Copy on first write, so everyone else sharing the pushed Scope keeps seeing the original
+        ScopeFrame& frame = m_scopeStack.Top();
+        if (frame.m_copy == nullptr)
+        {
+            frame.m_copy = frame.m_scope->Clone();
+        }
+
+        return *frame.m_copy;
+    }
+
     void WorldState::SetGameTime(GameTime& gameTime)
     {
         m_gameTime = gameTime;
@@ -69,7 +117,7 @@ namespace FieaGameEngine
         // Perform pending create action requests
         for (CreateActionRequest& request : m_createActionRequests)
         {
-            Scope* newScope = Factory<Scope>::Create(request.m_className);
+            Scope* newScope = (request.m_factory != nullptr) ? request.m_factory->Create() : Factory<Scope>::Create(request.m_className);
             if (newScope == nullptr)
             {
                 throw std::exception("Trying to create an Action with a class who has no factory!");
@@ -85,6 +133,7 @@ namespace FieaGameEngine
 
             newAction->SetName(request.m_name);
             request.m_context.Adopt(*newAction, "Actions");
+            newAction->Init(this);
         }
         m_createActionRequests.Clear();
 
@@ -111,6 +160,11 @@ namespace FieaGameEngine
         m_createActionRequests.PushBack(CreateActionRequest(className, name, context));
     }
 
+    void WorldState::AddCreateActionRequest(const Factory<Scope>& factory, std::string& name, Scope& context)
+    {
+        m_createActionRequests.PushBack(CreateActionRequest(factory.ClassName(), name, context, &factory));
+    }
+
     void WorldState::DestroyEntity(Entity* entity)
     {
         if (!entity->IsPendingDestruction())
@@ -122,24 +176,17 @@ namespace FieaGameEngine
 
     bool WorldState::AttemptDestroyAction(const std::string& name, Scope& context)
     {
-        Datum* actionsDatum = context.Find("Actions");
+        Datum* actionsDatum = nullptr;
         bool elementFound = false;
 
-        if (actionsDatum)
+        size_t index = 0;
+        if (Action::FindByName(context, name, actionsDatum, index))
         {
-            for (size_t i = 0; i < actionsDatum->Size(); ++i)
-            {
-                Scope& scope = actionsDatum->Get<Scope>(i);
-                Action& action = static_cast<Action&>(scope);
-
-                if (action.GetName() == name)
-                {
-                    delete& action;
-                    actionsDatum->RemoveAt(i);
-                    elementFound = true;
-                    break;
-                }
-            }
+            // Remove before deleting, so the destructor renumbers the Actions that shifted down
+            Scope& action = actionsDatum->Get<Scope>(index);
+            actionsDatum->RemoveAt(index);
+            delete &action;
+            elementFound = true;
         }
 
         if (!elementFound && context.GetParent() != nullptr)
@@ -62,6 +62,15 @@ namespace FieaGameEngine
         /// <param name="context"> The context to create this Action in </param>
         void AddCreateActionRequest(const std::string& className, std::string& name, Scope& context);
 
+        /// <summary>
+        /// Adds a create action request that uses an already resolved factory, skipping the
+        /// class name lookup when the request is processed
+        /// </summary>
+        /// <param name="factory"> The factory of the class to construct </param>
+        /// <param name="name"> The name to give the new Action </param>
+        /// <param name="context"> The context to create this Action in </param>
+        void AddCreateActionRequest(const Factory<Scope>& factory, std::string& name, Scope& context);
+
         /// <summary>
         /// Destroys an entity by removing it from its parent and deleting its memory. The destroy will actually
         /// occur next tick as to not mess with the current update loop.
@@ -80,9 +89,46 @@ namespace FieaGameEngine
         Entity* Instantiate(const std::string& className, glm::vec4 position, Entity* parent = nullptr);
         #pragma endregion
 
-        Stack<Scope*> m_scopeStack;
+        /// <summary>
+        /// Pushes a read-only Scope, such as an event payload, onto the scope stack. The Scope
+        /// is not copied, so it must outlive the matching PopScope call.
+        /// </summary>
+        /// <param name="scope"> The Scope to push </param>
+        void PushScope(const Scope& scope);
+
+        /// <summary>
+        /// Pops the top of the scope stack, deleting the private copy of it if one was made
+        /// </summary>
+        void PopScope();
+
+        /// <summary>
+        /// Gets the top of the scope stack for reading
+        /// </summary>
+        /// <returns> The top Scope, or nullptr if the stack is empty </returns>
+        const Scope* TopScope() const;
+
+        /// <summary>
+        /// Gets the top of the scope stack for writing. The first call for a given push clones
+        /// the pushed Scope, and the clone is what is read and written from then on, so the
+        /// shared original is never modified.
+        /// </summary>
+        /// <returns> A writable copy of the top Scope </returns>
+        /// <exception cref="std::exception"> Throws if the stack is empty </exception>
+        Scope& MutableTopScope();
 
 	private:
+        /// <summary>
+        /// Struct that represents one entry on the scope stack
+        /// </summary>
+        struct ScopeFrame
+        {
+            const Scope* m_scope;
+            gsl::owner<Scope*> m_copy;
+
+            ScopeFrame(const Scope& scope)
+                : m_scope(&scope), m_copy(nullptr) {}
+        };
+
         /// <summary>
         /// Struct that represents a queued DestroyAction request
         /// </summary>
@@ -103,9 +149,10 @@ namespace FieaGameEngine
             const std::string& m_className;
             const std::string& m_name;
             Scope& m_context;
+            const Factory<Scope>* m_factory;
 
-            CreateActionRequest(const std::string& className, const std::string& name, Scope& context)
-                : m_className(className), m_name(name), m_context(context) {}
+            CreateActionRequest(const std::string& className, const std::string& name, Scope& context, const Factory<Scope>* factory = nullptr)
+                : m_className(className), m_name(name), m_context(context), m_factory(factory) {}
         };
 
         /// <summary>
@@ -161,6 +208,12 @@ namespace FieaGameEngine
         /// </summary>
         EventQueue* m_eventQueue;
 
+        /// <summary>
+        /// Stack of Scopes that reactions and their actions can read from, such as the payload
+        /// of the event being handled
+        /// </summary>
+        Stack<ScopeFrame> m_scopeStack;
+
         /// <summary>
         /// Recursive function that attempts to find the target action and then destroy it. This will
         /// recurse up the hierarchy searching for the action.
@@ -142,18 +142,4 @@ namespace FieaGameEngine
 
         Entity::Update(worldState);
     }
-
-    const Vector<Signature> PhysicsEntity::Signatures()
-    {
-        return Vector<Signature>
-        {
-            { "BodyType", Datum::DatumType::String, 1, offsetof(PhysicsEntity, m_bodyType) },
-            { "GravityScale", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.gravityScale) },
-            { "LinearDamping", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.linearDamping) },
-            { "AngularDamping", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.angularDamping) },
-            { "Density", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingFixture.density) },
-            { "Friction", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingFixture.friction) },
-            { "IsTrigger", Datum::DatumType::Integer, 1, offsetof(PhysicsEntity, m_isTrigger) }
-        };
-    }
 }
\ No newline at end of file
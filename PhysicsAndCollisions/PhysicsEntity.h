@@ -8,6 +8,7 @@ namespace FieaGameEngine
 {
 	class PhysicsEntity : public Entity
 	{
+		POOL_DECLARATIONS(PhysicsEntity);
 		RTTI_DECLARATIONS(PhysicsEntity, Entity);
 	public:
 
@@ -36,9 +37,21 @@ namespace FieaGameEngine
 		/// Retrieves the Signatures for this class, which describe its prescribed 
 		/// attributes
 		/// </summary>
-		/// <returns> A Vector of Signatures representing the prescribed attributes
+		/// <returns> A compile time table of Signatures representing the prescribed attributes
 		/// of this class </returns>
-		static const Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 7> Signatures()
+		{
+			return std::array<StaticSignature, 7>
+			{ {
+				{ "BodyType", Datum::DatumType::String, 1, offsetof(PhysicsEntity, m_bodyType) },
+				{ "GravityScale", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.gravityScale) },
+				{ "LinearDamping", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.linearDamping) },
+				{ "AngularDamping", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingDef.angularDamping) },
+				{ "Density", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingFixture.density) },
+				{ "Friction", Datum::DatumType::Float, 1, offsetof(PhysicsEntity, m_startingFixture.friction) },
+				{ "IsTrigger", Datum::DatumType::Integer, 1, offsetof(PhysicsEntity, m_isTrigger) }
+			} };
+		}
 
 		#pragma region Box2D Getters/Setters
 		const b2Vec2& GetLinearVelocity() const { return m_body->GetLinearVelocity(); }
@@ -140,6 +153,6 @@ namespace FieaGameEngine
 		};
 	};
 
-	ConcreteFactory(PhysicsEntity, Scope);
+	PooledConcreteFactory(PhysicsEntity, Scope);
 }
 
@@ -11,17 +11,6 @@ namespace FieaGameEngine
 	{
 	}
 
-	const Vector<Signature> Animation::Signatures()
-	{
-		return Vector<Signature>
-		{
-			{ "TimeBetween", Datum::DatumType::Float, 1, offsetof(Animation, m_TimeBetween) },
-			{ "SpriteWidth", Datum::DatumType::Integer, 1, offsetof(Animation, m_SpriteWidth) },
-			{ "StateName", Datum::DatumType::String, 1, offsetof(Animation, m_StateName) },
-			{ "SpriteSheet", Datum::DatumType::String, 1, offsetof(Animation, m_SpriteSheet) },
-		};
-	}
-
 	void Animation::Initialize()
 	{
 
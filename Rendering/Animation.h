@@ -28,7 +28,16 @@ namespace FieaGameEngine
 	public:
 		Animation();
 
-		const static Vector<Signature> Signatures();
+		static constexpr std::array<StaticSignature, 4> Signatures()
+		{
+			return std::array<StaticSignature, 4>
+			{ {
+				{ "TimeBetween", Datum::DatumType::Float, 1, offsetof(Animation, m_TimeBetween) },
+				{ "SpriteWidth", Datum::DatumType::Integer, 1, offsetof(Animation, m_SpriteWidth) },
+				{ "StateName", Datum::DatumType::String, 1, offsetof(Animation, m_StateName) },
+				{ "SpriteSheet", Datum::DatumType::String, 1, offsetof(Animation, m_SpriteSheet) }
+			} };
+		}
 
 		void Initialize();
 		void Update();